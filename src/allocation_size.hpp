@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace blck
+{
+    namespace detail
+    {
+        // sizeof(T) * Count must not wrap into a small block, same as std::allocator
+        template <typename T>
+        inline void CheckAllocationCount(size_t Count)
+        {
+            if (Count > SIZE_MAX / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+        }
+    }
+} // namespace blck
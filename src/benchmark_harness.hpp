@@ -0,0 +1,217 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace blck
+{
+    // Micro-benchmark harness: warm-up, auto-calibrated iteration counts and
+    // many timed samples per measurement, reported as a distribution.
+    // A single clock read around one push_back measures the clock, not the
+    // push_back; here every sample runs the body enough times to last at least
+    // min_sample_time and the per-operation time is sample time / iterations.
+    namespace bench
+    {
+        // Keeps Value (and everything it points to) alive as far as the optimizer is concerned
+        template <typename T>
+        inline void do_not_optimize(const T &Value)
+        {
+            asm volatile("" : : "r,m"(Value) : "memory");
+        }
+
+        template <typename T>
+        inline void do_not_optimize(T &Value)
+        {
+            // GCC rejects a "+r,m" alternative at -O3, pick the constraint by type
+            if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void *))
+            {
+                asm volatile("" : "+r"(Value) : : "memory");
+            }
+            else
+            {
+                asm volatile("" : "+m"(Value) : : "memory");
+            }
+        }
+
+        // Forces pending stores to be considered observable
+        inline void clobber_memory()
+        {
+            asm volatile("" : : : "memory");
+        }
+
+        struct options
+        {
+            // Untimed samples run before measuring (caches, branch predictors, page faults)
+            size_t warmup_samples = 3;
+            // Timed samples the statistics are computed from
+            size_t samples = 31;
+            // Calibration target for one sample, well above clock resolution
+            std::chrono::nanoseconds min_sample_time = std::chrono::microseconds(500);
+            // Cap for bodies that are too fast to measure any other way
+            size_t max_iterations = size_t(1) << 28;
+        };
+
+        // Per-operation times in nanoseconds
+        struct result
+        {
+            std::string name;
+            size_t iterations = 0; // per sample
+            size_t samples = 0;
+            double mean_ns = 0.0;
+            double median_ns = 0.0;
+            double p90_ns = 0.0;
+            double p99_ns = 0.0;
+            double min_ns = 0.0;
+            double max_ns = 0.0;
+            double stddev_ns = 0.0;
+            // Median absolute deviation, a spread that ignores the odd preempted sample
+            double mad_ns = 0.0;
+
+            // Relative spread, above a few percent the machine was busy
+            double cv() const noexcept
+            {
+                return mean_ns > 0.0 ? stddev_ns / mean_ns : 0.0;
+            }
+        };
+
+        namespace detail
+        {
+            using Clock = std::chrono::steady_clock;
+
+            // Nearest-rank percentile of sorted samples
+            inline double Percentile(const std::vector<double> &Sorted, double Fraction)
+            {
+                size_t Rank = static_cast<size_t>(std::ceil(Fraction * static_cast<double>(Sorted.size())));
+                return Sorted[Rank == 0 ? 0 : Rank - 1];
+            }
+
+            inline result Summarize(std::string Name, size_t Iterations, std::vector<double> &PerOp)
+            {
+                result Result;
+                Result.name = std::move(Name);
+                Result.iterations = Iterations;
+                Result.samples = PerOp.size();
+                if (PerOp.empty())
+                {
+                    return Result;
+                }
+                std::sort(PerOp.begin(), PerOp.end());
+                double Sum = 0.0;
+                for (double Value : PerOp)
+                {
+                    Sum += Value;
+                }
+                Result.mean_ns = Sum / static_cast<double>(PerOp.size());
+                double Squares = 0.0;
+                for (double Value : PerOp)
+                {
+                    Squares += (Value - Result.mean_ns) * (Value - Result.mean_ns);
+                }
+                Result.stddev_ns = PerOp.size() > 1 ? std::sqrt(Squares / static_cast<double>(PerOp.size() - 1)) : 0.0;
+                Result.median_ns = Percentile(PerOp, 0.5);
+                Result.p90_ns = Percentile(PerOp, 0.9);
+                Result.p99_ns = Percentile(PerOp, 0.99);
+                Result.min_ns = PerOp.front();
+                Result.max_ns = PerOp.back();
+                std::vector<double> Deviations;
+                Deviations.reserve(PerOp.size());
+                for (double Value : PerOp)
+                {
+                    Deviations.push_back(std::fabs(Value - Result.median_ns));
+                }
+                std::sort(Deviations.begin(), Deviations.end());
+                Result.mad_ns = Percentile(Deviations, 0.5);
+                return Result;
+            }
+
+            // Runs one sample of Iterations calls on fresh state, returns its duration
+            template <typename Setup, typename Body>
+            inline Clock::duration TimeSample(Setup &MakeState, Body &Run, size_t Iterations)
+            {
+                auto State = MakeState();
+                clobber_memory();
+                auto Start = Clock::now();
+                for (size_t i = 0; i < Iterations; i++)
+                {
+                    Run(State);
+                }
+                clobber_memory();
+                auto End = Clock::now();
+                do_not_optimize(State);
+                return End - Start;
+            }
+
+            // Grows the iteration count until one sample lasts min_sample_time
+            template <typename Setup, typename Body>
+            inline size_t Calibrate(Setup &MakeState, Body &Run, const options &Options)
+            {
+                size_t Iterations = 1;
+                while (Iterations < Options.max_iterations)
+                {
+                    auto Elapsed = TimeSample(MakeState, Run, Iterations);
+                    if (Elapsed >= Options.min_sample_time)
+                    {
+                        break;
+                    }
+                    // Aim 40% past the target from the current rate, at most 10x per step
+                    double Ratio = Elapsed.count() > 0
+                                       ? 1.4 * static_cast<double>(Options.min_sample_time.count()) / static_cast<double>(Elapsed.count())
+                                       : 10.0;
+                    Ratio = std::min(std::max(Ratio, 2.0), 10.0);
+                    Iterations = std::min(static_cast<size_t>(static_cast<double>(Iterations) * Ratio), Options.max_iterations);
+                }
+                return Iterations;
+            }
+        }
+
+        // Measures Run(State) where State comes fresh from MakeState() for every
+        // sample, outside the timed region. Use it when the body changes the
+        // state (push_back into an empty container, pop_back from a full one).
+        template <typename Setup, typename Body>
+        result run(std::string Name, Setup MakeState, Body Run, const options &Options = options())
+        {
+            size_t Iterations = detail::Calibrate(MakeState, Run, Options);
+            for (size_t i = 0; i < Options.warmup_samples; i++)
+            {
+                detail::TimeSample(MakeState, Run, Iterations);
+            }
+            std::vector<double> PerOp;
+            PerOp.reserve(Options.samples);
+            for (size_t i = 0; i < Options.samples; i++)
+            {
+                auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(detail::TimeSample(MakeState, Run, Iterations));
+                PerOp.push_back(static_cast<double>(Elapsed.count()) / static_cast<double>(Iterations));
+            }
+            return detail::Summarize(std::move(Name), Iterations, PerOp);
+        }
+
+        // Measures a body without per-sample state
+        template <typename Body>
+        result run(std::string Name, Body Run, const options &Options = options())
+        {
+            return run(std::move(Name), [] { return 0; }, [&Run](int &) { Run(); }, Options);
+        }
+
+        // True when the medians of A and B differ by more than their noise:
+        // three standard errors of the difference, with the spread estimated from
+        // the MAD (scaled to a normal sigma) so a few outliers cannot hide a real gap
+        inline bool significant(const result &A, const result &B)
+        {
+            if (A.samples == 0 || B.samples == 0)
+            {
+                return false;
+            }
+            double SigmaA = 1.4826 * A.mad_ns;
+            double SigmaB = 1.4826 * B.mad_ns;
+            double Error = std::sqrt(SigmaA * SigmaA / static_cast<double>(A.samples) +
+                                     SigmaB * SigmaB / static_cast<double>(B.samples));
+            return std::fabs(A.median_ns - B.median_ns) > 3.0 * Error;
+        }
+    }
+
+} // namespace blck
@@ -0,0 +1,208 @@
+#include "rotcev.hpp"
+#include "benchmark_harness.hpp"
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Statistically robust rotcev vs std::vector comparisons.
+// Every case is measured with blck::bench (warm-up, calibrated iterations,
+// many samples) and reported as median / p90 / p99 / stddev per operation.
+// A difference only counts as a win or a loss when it is larger than the
+// measured noise; otherwise the verdict is "noise".
+
+namespace
+{
+    using blck::bench::result;
+
+    struct BenchCase
+    {
+        std::string Name;
+        std::function<std::pair<result, result>(const blck::bench::options &)> Run;
+    };
+
+    // Elements in the prefilled containers the read-only cases work on
+    constexpr size_t FilledSize = 4096;
+
+    template <typename Container, typename T>
+    Container MakeFilled(const T &Value)
+    {
+        Container Filled;
+        for (size_t i = 0; i < FilledSize; i++)
+        {
+            Filled.push_back(Value);
+        }
+        return Filled;
+    }
+
+    template <typename T>
+    void AddContainerCases(std::vector<BenchCase> &Cases, const std::string &TypeName, T Value)
+    {
+        using Rotcev = blck::rotcev<T>;
+        using Vector = std::vector<T>;
+
+        Cases.push_back({TypeName + "/push_back", [Value](const blck::bench::options &Options) {
+            auto Measure = [&](auto Empty) {
+                using C = decltype(Empty);
+                return blck::bench::run("push_back", [] { return C(); }, [&Value](C &Container) {
+                    Container.push_back(Value);
+                }, Options);
+            };
+            return std::make_pair(Measure(Rotcev()), Measure(Vector()));
+        }});
+
+        Cases.push_back({TypeName + "/operator[]", [Value](const blck::bench::options &Options) {
+            auto Measure = [&](auto Filled) {
+                size_t Index = 0;
+                return blck::bench::run("operator[]", [&] {
+                    // Reading through a reference the compiler cannot drop
+                    const auto &Element = Filled[Index++ & (FilledSize - 1)];
+                    blck::bench::do_not_optimize(Element);
+                }, Options);
+            };
+            return std::make_pair(Measure(MakeFilled<Rotcev>(Value)), Measure(MakeFilled<Vector>(Value)));
+        }});
+
+        Cases.push_back({TypeName + "/iterate 4096", [Value](const blck::bench::options &Options) {
+            auto Measure = [&](auto Filled) {
+                return blck::bench::run("iterate", [&] {
+                    for (const auto &Element : Filled)
+                    {
+                        blck::bench::do_not_optimize(Element);
+                    }
+                }, Options);
+            };
+            return std::make_pair(Measure(MakeFilled<Rotcev>(Value)), Measure(MakeFilled<Vector>(Value)));
+        }});
+
+        Cases.push_back({TypeName + "/copy 4096", [Value](const blck::bench::options &Options) {
+            auto Measure = [&](auto Filled) {
+                return blck::bench::run("copy", [&] {
+                    auto Copy = Filled;
+                    blck::bench::do_not_optimize(Copy);
+                }, Options);
+            };
+            return std::make_pair(Measure(MakeFilled<Rotcev>(Value)), Measure(MakeFilled<Vector>(Value)));
+        }});
+
+        Cases.push_back({TypeName + "/fill 4096 reserved", [Value](const blck::bench::options &Options) {
+            auto Measure = [&](auto Empty) {
+                using C = decltype(Empty);
+                return blck::bench::run("fill reserved", [&] {
+                    C Container;
+                    Container.reserve(FilledSize);
+                    for (size_t i = 0; i < FilledSize; i++)
+                    {
+                        Container.push_back(Value);
+                    }
+                    blck::bench::do_not_optimize(Container);
+                }, Options);
+            };
+            return std::make_pair(Measure(Rotcev()), Measure(Vector()));
+        }});
+    }
+
+    std::vector<BenchCase> MakeCases()
+    {
+        std::vector<BenchCase> Cases;
+        AddContainerCases<int>(Cases, "int", 42);
+        AddContainerCases<double>(Cases, "double", 3.14159);
+        AddContainerCases<std::string>(Cases, "std::string", std::string("This is a longer string for testing"));
+        return Cases;
+    }
+
+    void PrintTableHeader()
+    {
+        std::cout << std::left << std::setw(30) << "case"
+                  << std::right << std::setw(12) << "rotcev med"
+                  << std::setw(12) << "vector med"
+                  << std::setw(12) << "rotcev p99"
+                  << std::setw(12) << "vector p99"
+                  << std::setw(10) << "cv %"
+                  << std::setw(9) << "ratio"
+                  << "  verdict\n";
+        std::cout << std::string(110, '-') << "\n";
+    }
+
+    void PrintRow(const std::string &Name, const result &Rotcev, const result &Vector)
+    {
+        double Ratio = Rotcev.median_ns > 0.0 ? Vector.median_ns / Rotcev.median_ns : 0.0;
+        const char *Verdict = !blck::bench::significant(Rotcev, Vector) ? "noise"
+                              : Rotcev.median_ns < Vector.median_ns      ? "rotcev faster"
+                                                                         : "rotcev slower";
+        std::cout << std::left << std::setw(30) << Name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << Rotcev.median_ns
+                  << std::setw(12) << Vector.median_ns
+                  << std::setw(12) << Rotcev.p99_ns
+                  << std::setw(12) << Vector.p99_ns
+                  << std::setw(10) << 100.0 * std::max(Rotcev.cv(), Vector.cv())
+                  << std::setw(8) << Ratio << "x"
+                  << "  " << Verdict << "\n";
+    }
+
+    void PrintUsage(const char *Program)
+    {
+        std::cerr << "Usage: " << Program << " [--filter <substring>] [--samples <n>] [--min-time-us <n>] [--list]" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    blck::bench::options Options;
+    std::string Filter;
+    bool ListOnly = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string Arg = argv[i];
+        bool HasValue = i + 1 < argc;
+        if (Arg == "--filter" && HasValue)
+        {
+            Filter = argv[++i];
+        }
+        else if (Arg == "--samples" && HasValue)
+        {
+            Options.samples = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (Arg == "--min-time-us" && HasValue)
+        {
+            Options.min_sample_time = std::chrono::microseconds(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (Arg == "--list")
+        {
+            ListOnly = true;
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<BenchCase> Cases = MakeCases();
+    if (ListOnly)
+    {
+        for (const BenchCase &Case : Cases)
+        {
+            std::cout << Case.Name << "\n";
+        }
+        return 0;
+    }
+
+    std::cout << "samples: " << Options.samples << ", warm-up samples: " << Options.warmup_samples
+              << ", min sample time: " << std::chrono::duration_cast<std::chrono::microseconds>(Options.min_sample_time).count()
+              << " us (times are ns per operation)\n\n";
+    PrintTableHeader();
+    for (const BenchCase &Case : Cases)
+    {
+        if (!Filter.empty() && Case.Name.find(Filter) == std::string::npos)
+        {
+            continue;
+        }
+        auto [Rotcev, Vector] = Case.Run(Options);
+        PrintRow(Case.Name, Rotcev, Vector);
+    }
+    return 0;
+}
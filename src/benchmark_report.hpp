@@ -0,0 +1,440 @@
+#pragma once
+#include "perf_counters.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifndef ROTCEV_BUILD_TYPE
+#define ROTCEV_BUILD_TYPE "unknown"
+#endif
+#ifndef ROTCEV_CXX_FLAGS
+#define ROTCEV_CXX_FLAGS ""
+#endif
+
+// Machine-readable output for the profiling run and comparison against a
+// stored baseline. Every printResult() call becomes one BenchmarkRecord;
+// the records plus the environment can be written as JSON or CSV, and a
+// later run can be checked against such a file. Single timings of one pass
+// easily move by 20-30% on their own, so -test --repeat N runs the suite N
+// times and every record carries its median and the spread between runs.
+
+struct BenchmarkRecord {
+    std::string section;
+    std::string name;
+    std::string type;
+    long long size = 0; // leading number of the test name, 0 when there is none
+    long long rotcev_ns = 0; // median over the runs
+    long long std_ns = 0;
+    int runs = 1;
+    // Robust sigma (1.4826 * MAD) of ln(rotcev_ns / std_ns) over the runs
+    double ratio_sigma = 0.0;
+    // perf counters of the first run (-test --counters), per side, and the
+    // operations they cover for per-element figures
+    blck::bench::counter_values rotcev_counters;
+    blck::bench::counter_values std_counters;
+    long long rotcev_elements = 0;
+    long long std_elements = 0;
+};
+
+struct BenchmarkEnvironment {
+    std::string cpu_model;
+    std::string compiler;
+    std::string build_type;
+    std::string cxx_flags;
+    unsigned hardware_threads = 0;
+    std::string timestamp;
+};
+
+// Where -test writes its results and what it compares them against
+struct BenchmarkOutputOptions {
+    std::string json_path;
+    std::string csv_path;
+    std::string baseline_path;
+    // Full benchmark passes; the records keep the per-test median and spread
+    int repeat = 1;
+    // Collect perf_event_open counters per case
+    bool counters = false;
+    // Smallest slowdown of the rotcev / std::vector ratio that can fail the run
+    double max_regression = 0.10;
+    // Single-shot timings below this swing too much to gate the run
+    long long gate_min_ns = 10000;
+};
+
+inline long long leadingNumber(const std::string& text) {
+    size_t digits = 0;
+    while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits]))) {
+        digits++;
+    }
+    return digits ? std::stoll(text.substr(0, digits)) : 0;
+}
+
+// Elements a test name talks about: its first number, "1000x1000" counts as
+// the product; 0 when the name has no number
+inline long long elementCount(const std::string& text) {
+    size_t start = 0;
+    while (start < text.size() && !std::isdigit(static_cast<unsigned char>(text[start]))) start++;
+    long long count = 0;
+    while (start < text.size()) {
+        size_t digits = start;
+        while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits]))) digits++;
+        long long factor = std::strtoll(text.substr(start, digits - start).c_str(), nullptr, 10);
+        count = count ? count * factor : factor;
+        if (digits + 1 >= text.size() || text[digits] != 'x' || !std::isdigit(static_cast<unsigned char>(text[digits + 1]))) break;
+        start = digits + 1;
+    }
+    return count;
+}
+
+inline BenchmarkEnvironment collectEnvironment() {
+    BenchmarkEnvironment env;
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                env.cpu_model = line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+            break;
+        }
+    }
+    if (env.cpu_model.empty()) env.cpu_model = "unknown";
+#if defined(__clang__)
+    env.compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    env.compiler = std::string("g++ ") + __VERSION__;
+#else
+    env.compiler = "unknown";
+#endif
+    env.build_type = ROTCEV_BUILD_TYPE;
+    env.cxx_flags = ROTCEV_CXX_FLAGS;
+    env.hardware_threads = std::thread::hardware_concurrency();
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    std::ostringstream stamp;
+    stamp << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ");
+    env.timestamp = stamp.str();
+    return env;
+}
+
+inline std::string jsonEscape(const std::string& text) {
+    std::ostringstream out;
+    for (unsigned char c : text) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    return out.str();
+}
+
+inline std::string csvEscape(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+inline bool writeJsonReport(const std::string& path, const BenchmarkEnvironment& env, const std::vector<BenchmarkRecord>& records) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    out << "{\n  \"environment\": {\n"
+        << "    \"cpu_model\": \"" << jsonEscape(env.cpu_model) << "\",\n"
+        << "    \"compiler\": \"" << jsonEscape(env.compiler) << "\",\n"
+        << "    \"build_type\": \"" << jsonEscape(env.build_type) << "\",\n"
+        << "    \"cxx_flags\": \"" << jsonEscape(env.cxx_flags) << "\",\n"
+        << "    \"hardware_threads\": " << env.hardware_threads << ",\n"
+        << "    \"timestamp\": \"" << jsonEscape(env.timestamp) << "\"\n  },\n"
+        << "  \"results\": [";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const BenchmarkRecord& r = records[i];
+        out << (i ? ",\n" : "\n")
+            << "    {\"section\": \"" << jsonEscape(r.section) << "\", \"name\": \"" << jsonEscape(r.name)
+            << "\", \"type\": \"" << jsonEscape(r.type) << "\", \"size\": " << r.size
+            << ", \"rotcev_ns\": " << r.rotcev_ns << ", \"std_ns\": " << r.std_ns
+            << ", \"runs\": " << r.runs << ", \"ratio_sigma\": " << r.ratio_sigma;
+        if (r.rotcev_counters.any() || r.std_counters.any()) {
+            out << ", \"rotcev_elements\": " << r.rotcev_elements << ", \"std_elements\": " << r.std_elements;
+        }
+        for (size_t c = 0; c < blck::bench::counter_count; ++c) {
+            auto counter = static_cast<blck::bench::counter>(c);
+            if (r.rotcev_counters.has(counter)) out << ", \"rotcev_" << blck::bench::counter_name(counter) << "\": " << r.rotcev_counters[counter];
+            if (r.std_counters.has(counter)) out << ", \"std_" << blck::bench::counter_name(counter) << "\": " << r.std_counters[counter];
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+inline bool writeCsvReport(const std::string& path, const BenchmarkEnvironment& env, const std::vector<BenchmarkRecord>& records) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    // Environment as comment lines, most CSV readers can skip them
+    out << "# cpu_model: " << env.cpu_model << "\n"
+        << "# compiler: " << env.compiler << "\n"
+        << "# build_type: " << env.build_type << "\n"
+        << "# cxx_flags: " << env.cxx_flags << "\n"
+        << "# hardware_threads: " << env.hardware_threads << "\n"
+        << "# timestamp: " << env.timestamp << "\n"
+        << "section,name,type,size,rotcev_ns,std_ns,runs,ratio_sigma,rotcev_elements,std_elements";
+    for (const char* side : {"rotcev_", "std_"}) {
+        for (size_t c = 0; c < blck::bench::counter_count; ++c) {
+            out << "," << side << blck::bench::counter_name(static_cast<blck::bench::counter>(c));
+        }
+    }
+    out << "\n";
+    for (const BenchmarkRecord& r : records) {
+        out << csvEscape(r.section) << "," << csvEscape(r.name) << "," << csvEscape(r.type) << ","
+            << r.size << "," << r.rotcev_ns << "," << r.std_ns << "," << r.runs << "," << r.ratio_sigma << ","
+            << r.rotcev_elements << "," << r.std_elements;
+        // Counters the kernel did not provide stay empty
+        for (const blck::bench::counter_values* values : {&r.rotcev_counters, &r.std_counters}) {
+            for (size_t c = 0; c < blck::bench::counter_count; ++c) {
+                out << ",";
+                if (values->valid[c]) out << values->value[c];
+            }
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+// Reads the "results" array of a file written by writeJsonReport.
+// Only understands flat objects of strings and numbers, which is all we write.
+inline bool readJsonReport(const std::string& path, std::vector<BenchmarkRecord>& records) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    size_t pos = text.find("\"results\"");
+    if (pos == std::string::npos) return false;
+    pos = text.find('[', pos);
+    if (pos == std::string::npos) return false;
+
+    auto skipSpace = [&]() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    };
+    auto readString = [&](std::string& value) {
+        value.clear();
+        if (text[pos] != '"') return false;
+        for (pos++; pos < text.size() && text[pos] != '"'; pos++) {
+            if (text[pos] == '\\' && pos + 1 < text.size()) {
+                char escaped = text[++pos];
+                if (escaped == 'n') value += '\n';
+                else if (escaped == 't') value += '\t';
+                else if (escaped == 'u' && pos + 4 < text.size()) {
+                    value += static_cast<char>(std::strtol(text.substr(pos + 1, 4).c_str(), nullptr, 16));
+                    pos += 4;
+                } else value += escaped;
+            } else {
+                value += text[pos];
+            }
+        }
+        pos++;
+        return pos <= text.size();
+    };
+
+    pos++;
+    while (true) {
+        skipSpace();
+        if (pos >= text.size()) return false;
+        if (text[pos] == ']') break;
+        if (text[pos] == ',') { pos++; continue; }
+        if (text[pos] != '{') return false;
+        pos++;
+        std::map<std::string, std::string> fields;
+        while (true) {
+            skipSpace();
+            if (pos >= text.size()) return false;
+            if (text[pos] == '}') { pos++; break; }
+            if (text[pos] == ',') { pos++; continue; }
+            std::string key, value;
+            if (!readString(key)) return false;
+            skipSpace();
+            if (pos >= text.size() || text[pos] != ':') return false;
+            pos++;
+            skipSpace();
+            if (pos < text.size() && text[pos] == '"') {
+                if (!readString(value)) return false;
+            } else {
+                size_t end = text.find_first_of(",}", pos);
+                if (end == std::string::npos) return false;
+                value = text.substr(pos, end - pos);
+                while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) value.pop_back();
+                pos = end;
+            }
+            fields[key] = value;
+        }
+        BenchmarkRecord r;
+        r.section = fields["section"];
+        r.name = fields["name"];
+        r.type = fields["type"];
+        r.size = std::strtoll(fields["size"].c_str(), nullptr, 10);
+        r.rotcev_ns = std::strtoll(fields["rotcev_ns"].c_str(), nullptr, 10);
+        r.std_ns = std::strtoll(fields["std_ns"].c_str(), nullptr, 10);
+        r.runs = std::max(1, std::atoi(fields["runs"].c_str()));
+        r.ratio_sigma = std::strtod(fields["ratio_sigma"].c_str(), nullptr);
+        records.push_back(r);
+    }
+    return true;
+}
+
+using BenchmarkKey = std::tuple<std::string, std::string, std::string, int>;
+
+// Tests can repeat a name inside a section, so the key carries the occurrence
+inline std::map<BenchmarkKey, const BenchmarkRecord*> keyRecords(const std::vector<BenchmarkRecord>& records) {
+    std::map<BenchmarkKey, const BenchmarkRecord*> byKey;
+    std::map<std::tuple<std::string, std::string, std::string>, int> seen;
+    for (const BenchmarkRecord& r : records) {
+        int occurrence = seen[{r.section, r.name, r.type}]++;
+        byKey[{r.section, r.name, r.type, occurrence}] = &r;
+    }
+    return byKey;
+}
+
+inline double medianOf(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+}
+
+inline double robustSigma(const std::vector<double>& values) {
+    if (values.size() < 2) return 0.0;
+    double median = medianOf(values);
+    std::vector<double> deviations;
+    for (double value : values) deviations.push_back(std::fabs(value - median));
+    return 1.4826 * medianOf(deviations);
+}
+
+// Folds the records of several passes into one record per test, in the order of the first pass
+inline std::vector<BenchmarkRecord> aggregateRuns(const std::vector<std::vector<BenchmarkRecord>>& runs) {
+    std::vector<BenchmarkRecord> merged;
+    if (runs.empty()) return merged;
+    std::vector<std::map<BenchmarkKey, const BenchmarkRecord*>> keyed;
+    for (const auto& run : runs) keyed.push_back(keyRecords(run));
+    std::map<std::tuple<std::string, std::string, std::string>, int> seen;
+    for (const BenchmarkRecord& first : runs.front()) {
+        BenchmarkKey key{first.section, first.name, first.type, seen[{first.section, first.name, first.type}]++};
+        std::vector<double> rotcev, vector, ratios;
+        for (const auto& run : keyed) {
+            auto match = run.find(key);
+            if (match == run.end()) continue;
+            const BenchmarkRecord& r = *match->second;
+            rotcev.push_back(static_cast<double>(r.rotcev_ns));
+            vector.push_back(static_cast<double>(r.std_ns));
+            ratios.push_back(std::log(std::max(r.rotcev_ns, 1LL) / static_cast<double>(std::max(r.std_ns, 1LL))));
+        }
+        BenchmarkRecord r = first;
+        r.rotcev_ns = std::llround(medianOf(rotcev));
+        r.std_ns = std::llround(medianOf(vector));
+        r.runs = static_cast<int>(ratios.size());
+        r.ratio_sigma = robustSigma(ratios);
+        merged.push_back(r);
+    }
+    return merged;
+}
+
+// Compares the rotcev / std::vector ratio of every test against the baseline.
+// Using the ratio cancels whatever made the whole machine faster or slower
+// between the two runs. With --repeat both sides carry a per-test spread and
+// the change is tested against the standard error of the two medians; a single
+// pass falls back to the spread of all changes across tests. A test regresses
+// when its change is both above max_regression and more than four standard
+// errors (about 100 tests are checked at once, three would flag one by chance
+// every few runs). Returns true when any test regressed.
+inline bool compareWithBaseline(const std::vector<BenchmarkRecord>& current,
+                                const std::vector<BenchmarkRecord>& baseline,
+                                const BenchmarkOutputOptions& options) {
+    auto baselineByKey = keyRecords(baseline);
+
+    struct Change {
+        const BenchmarkRecord* now;
+        const BenchmarkRecord* base;
+        double log_change;
+    };
+    std::vector<Change> changes;
+    size_t ungated = 0;
+    for (const auto& entry : keyRecords(current)) {
+        auto match = baselineByKey.find(entry.first);
+        if (match == baselineByKey.end()) continue;
+        const BenchmarkRecord* now = entry.second;
+        const BenchmarkRecord* base = match->second;
+        if (std::min({now->rotcev_ns, now->std_ns, base->rotcev_ns, base->std_ns}) < options.gate_min_ns) {
+            ungated++;
+            continue;
+        }
+        double ratio_now = static_cast<double>(now->rotcev_ns) / static_cast<double>(now->std_ns);
+        double ratio_base = static_cast<double>(base->rotcev_ns) / static_cast<double>(base->std_ns);
+        changes.push_back({now, base, std::log(ratio_now / ratio_base)});
+    }
+
+    std::cout << "\n" << std::string(60, '=') << "\n  BASELINE COMPARISON\n" << std::string(60, '=') << "\n";
+    std::cout << "Matched tests: " << changes.size() + ungated << " (" << ungated
+              << " below " << options.gate_min_ns << "ns, not gated)\n";
+    if (changes.empty()) {
+        std::cout << "Nothing to compare.\n";
+        return false;
+    }
+
+    std::vector<double> logChanges;
+    for (const Change& c : changes) logChanges.push_back(c.log_change);
+    // Spread of a single change when no per-test spread is known
+    double pooledSigma = std::max(robustSigma(logChanges), 0.02);
+    double minimumChange = std::log(1.0 + options.max_regression);
+    std::cout << "Runs: " << changes.front().now->runs << " now, " << changes.front().base->runs
+              << " baseline; smallest reported change: " << std::fixed << std::setprecision(1)
+              << 100.0 * options.max_regression << "%\n";
+
+    // Standard error of ln(ratio_now / ratio_base); 1.253 converts a sigma into the error of a median.
+    // Five runs can land close together by chance, hence the floor on the per-test sigma
+    auto standardError = [&](const Change& c) {
+        if (c.now->runs < 3 || c.base->runs < 3) return pooledSigma;
+        double now = 1.253 * std::max(c.now->ratio_sigma, 0.03) / std::sqrt(static_cast<double>(c.now->runs));
+        double base = 1.253 * std::max(c.base->ratio_sigma, 0.03) / std::sqrt(static_cast<double>(c.base->runs));
+        return std::sqrt(now * now + base * base);
+    };
+
+    size_t regressions = 0;
+    size_t improvements = 0;
+    for (const Change& c : changes) {
+        double threshold = std::max(minimumChange, 4.0 * standardError(c));
+        bool regressed = c.log_change > threshold;
+        bool improved = c.log_change < -threshold;
+        if (!regressed && !improved) continue;
+        (regressed ? regressions : improvements)++;
+        std::cout << (regressed ? "REGRESSION  " : "improvement ") << c.now->section << " / " << c.now->name
+                  << (c.now->type.empty() ? "" : " [" + c.now->type + "]") << ": " << std::setprecision(1)
+                  << std::showpos << 100.0 * (std::exp(c.log_change) - 1.0) << std::noshowpos
+                  << "% (rotcev/std " << std::setprecision(2)
+                  << static_cast<double>(c.base->rotcev_ns) / c.base->std_ns << " -> "
+                  << static_cast<double>(c.now->rotcev_ns) / c.now->std_ns << ", threshold "
+                  << std::setprecision(1) << (regressed ? "+" : "-")
+                  << 100.0 * (regressed ? std::exp(threshold) - 1.0 : 1.0 - std::exp(-threshold)) << "%)\n";
+    }
+    std::cout << regressions << " regression(s), " << improvements << " improvement(s) out of " << changes.size() << " gated tests\n";
+    return regressions > 0;
+}
@@ -1,4 +1,5 @@
 #include "rotcev.hpp"
+#include "jagged_rotcev.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -32,7 +33,7 @@ namespace Func
                 {
                     TempArray.push_back(j);
                 }
-                Input.push_back(TempArray);
+                Input.push_back(std::move(TempArray));
             }
 
             if constexpr (std::is_same<T, blck::rotcev<int*>>::value)
@@ -43,11 +44,86 @@ namespace Func
                     int* a = new int(j);
                     TempArray.push_back(a);
                 }
-                Input.push_back(TempArray);
+                Input.push_back(std::move(TempArray));
             }
         }
     }
 
+    // Nested rotcev vs jagged_rotcev of Rows x RowLength ints: build time,
+    // heap buffers and a full scan
+    void JaggedComparison(size_t Rows, size_t RowLength)
+    {
+        std::cout << HEADER << "Nested vs Jagged " << Rows << "x" << RowLength << std::endl;
+        long long NestedFill = 0, NestedScan = 0, JaggedFill = 0, JaggedScan = 0;
+        size_t NestedBuffers = 0, JaggedBuffers = 0;
+        volatile long long Sum = 0;
+        {
+            blck::rotcev<blck::rotcev<int>> Nested;
+            auto Start = std::chrono::high_resolution_clock::now();
+            // Same pattern as FillArray<blck::rotcev<int>>
+            for (size_t i = 0; i < Rows; i++)
+            {
+                blck::rotcev<int> TempArray;
+                TempArray.reserve(RowLength);
+                for (size_t j = 0; j < RowLength; j++)
+                {
+                    TempArray.push_back(j);
+                }
+                Nested.push_back(std::move(TempArray));
+            }
+            auto End = std::chrono::high_resolution_clock::now();
+            NestedFill = (End - Start).count();
+            // One buffer per row plus the outer one
+            NestedBuffers = Nested.size() + 1;
+
+            Start = std::chrono::high_resolution_clock::now();
+            long long Local = 0;
+            for (const auto& Row : Nested)
+            {
+                for (int Element : Row)
+                {
+                    Local += Element;
+                }
+            }
+            Sum = Local;
+            End = std::chrono::high_resolution_clock::now();
+            NestedScan = (End - Start).count();
+        }
+        {
+            blck::jagged_rotcev<int> Jagged;
+            auto Start = std::chrono::high_resolution_clock::now();
+            Jagged.reserve(Rows, Rows * RowLength);
+            for (size_t i = 0; i < Rows; i++)
+            {
+                Jagged.push_row();
+                for (size_t j = 0; j < RowLength; j++)
+                {
+                    Jagged.push_back(j);
+                }
+            }
+            auto End = std::chrono::high_resolution_clock::now();
+            JaggedFill = (End - Start).count();
+            // Values and row starts
+            JaggedBuffers = 2;
+
+            Start = std::chrono::high_resolution_clock::now();
+            long long Local = 0;
+            for (int Element : Jagged)
+            {
+                Local += Element;
+            }
+            Sum = Local;
+            End = std::chrono::high_resolution_clock::now();
+            JaggedScan = (End - Start).count();
+        }
+        (void)Sum;
+
+        std::cout << HEADER << "Fill nested: " << NestedFill << " ns, " << NestedBuffers << " buffers" << std::endl;
+        std::cout << HEADER << "Fill jagged: " << JaggedFill << " ns, " << JaggedBuffers << " buffers" << std::endl;
+        std::cout << HEADER << "Scan nested: " << NestedScan << " ns" << std::endl;
+        std::cout << HEADER << "Scan jagged: " << JaggedScan << " ns" << std::endl;
+    }
+
     void Insertions()
     {
         std::cout << HEADER << "Start Insertion Tests" << std::endl;
@@ -59,6 +135,10 @@ namespace Func
 
         std::vector<int> test;
 
+        // The FillArray shape, and many short rows where per-row buffers dominate
+        JaggedComparison(10000, 10000);
+        JaggedComparison(1000000, 8);
+
         FillArray<int>(IntContainer);
         FillArray<int*>(IntPtrContainer);
         FillArray<blck::rotcev<int>>(TwoDimInt);
@@ -98,7 +178,7 @@ namespace Func
 
         // std::cout << "looping through: " << TwoDimInt.Size()*10000 << " Elements Took: " << (end - now).count() << " nanoseconds";
 
-        for (auto InnerElement : TwoDimInt)
+        for (auto& InnerElement : TwoDimInt)
         {
             for (auto Element : InnerElement)
             {
@@ -0,0 +1,152 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// A table fitted by Rotcev_Profiling -tune, see growth_tuner.hpp
+#if defined(ROTCEV_GROWTH_FACTORS_HEADER)
+#include ROTCEV_GROWTH_FACTORS_HEADER
+#endif
+
+namespace blck
+{
+    // Growth policies decide the new capacity (in elements) when a rotcev runs
+    // out of room. Each one provides
+    //     template <typename T> static size_t next_capacity(size_t Size, size_t MinimumCapacity);
+    // and must return at least MinimumCapacity. Growth saturates at the largest
+    // element count whose byte size fits in size_t instead of wrapping around;
+    // the allocator then refuses what it cannot serve.
+
+    namespace detail
+    {
+        inline constexpr std::array<double, 4> growth_factors =
+#if defined(ROTCEV_TUNED_GROWTH_FACTORS)
+            ROTCEV_TUNED_GROWTH_FACTORS;
+#else
+        {
+            10.0, // tiny objects (1-8 bytes)
+            5.0,  // small objects (9-32 bytes)
+            2.0,  // medium objects (33-128 bytes)
+            1.5   // large objects (129+ bytes)
+        };
+#endif
+
+        template <typename T>
+        constexpr double get_growth_factor_factor()
+        {
+            size_t size = sizeof(T);
+            return growth_factors[
+                (size <= 8) ? 0 
+               :(size <= 32) ? 1
+               :(size <= 128)  ? 2
+               :3];
+        }
+
+        constexpr size_t RoundUpToPowerOfTwo(size_t Value)
+        {
+            if (Value > SIZE_MAX / 2 + 1)
+            {
+                throw std::length_error("blck: no power of two that large fits in size_t");
+            }
+            size_t Result = 1;
+            while (Result < Value)
+            {
+                Result <<= 1;
+            }
+            return Result;
+        }
+
+        // Most elements of T a buffer can hold without its byte size overflowing
+        template <typename T>
+        constexpr size_t MaxCapacity()
+        {
+            return SIZE_MAX / sizeof(T);
+        }
+
+        // Size * Numerator / Denominator, capped at MaxCapacity<T>()
+        template <typename T>
+        constexpr size_t ScaledCapacity(size_t Size, size_t Numerator, size_t Denominator = 1)
+        {
+            return (Size <= MaxCapacity<T>() / Numerator) ? Size * Numerator / Denominator : MaxCapacity<T>();
+        }
+    }
+
+    // The original rotcev behaviour: a growth factor picked by sizeof(T)
+    struct default_growth
+    {
+        template <typename T>
+        static size_t next_capacity(size_t Size, size_t MinimumCapacity)
+        {
+            double Grown = static_cast<double>(Size) * detail::get_growth_factor_factor<T>();
+            size_t NewAllocationSize = (Grown < static_cast<double>(detail::MaxCapacity<T>())) ? static_cast<size_t>(Grown)
+                                                                                               : detail::MaxCapacity<T>();
+            return std::max(NewAllocationSize, MinimumCapacity);
+        }
+    };
+
+    // Multiplies the size by Numerator / Denominator on every growth step
+    template <size_t Numerator = 2, size_t Denominator = 1>
+    struct geometric_growth
+    {
+        static_assert(Numerator > Denominator, "geometric_growth needs a factor above 1");
+
+        template <typename T>
+        static size_t next_capacity(size_t Size, size_t MinimumCapacity)
+        {
+            return std::max(detail::ScaledCapacity<T>(Size, Numerator, Denominator), MinimumCapacity);
+        }
+    };
+
+    // Doubles and rounds the buffer up to a power of two bytes, so every block
+    // lands exactly on an allocator size class
+    struct power_of_two_growth
+    {
+        template <typename T>
+        static size_t next_capacity(size_t Size, size_t MinimumCapacity)
+        {
+            size_t Elements = std::max(detail::ScaledCapacity<T>(Size, 2), MinimumCapacity);
+            if (Elements > (SIZE_MAX / 2 + 1) / sizeof(T))
+            {
+                // No larger power of two fits, stay at the saturated size
+                return Elements;
+            }
+            return detail::RoundUpToPowerOfTwo(Elements * sizeof(T)) / sizeof(T);
+        }
+    };
+
+    // Doubles and rounds the buffer up to whole pages, no partially used page at the tail
+    template <size_t PageBytes = 4096>
+    struct page_aligned_growth
+    {
+        static_assert((PageBytes & (PageBytes - 1)) == 0, "page size must be a power of two");
+
+        template <typename T>
+        static size_t next_capacity(size_t Size, size_t MinimumCapacity)
+        {
+            size_t Elements = std::max(detail::ScaledCapacity<T>(Size, 2), MinimumCapacity);
+            if (Elements > (SIZE_MAX - PageBytes + 1) / sizeof(T))
+            {
+                return Elements;
+            }
+            size_t Bytes = (Elements * sizeof(T) + PageBytes - 1) & ~(PageBytes - 1);
+            return Bytes / sizeof(T);
+        }
+    };
+
+    // Doubles until a growth step would add more than MaxStepBytes, then grows
+    // linearly by MaxStepBytes, bounding the slack of huge containers
+    template <size_t MaxStepBytes = (size_t(16) << 20)>
+    struct capped_linear_growth
+    {
+        template <typename T>
+        static size_t next_capacity(size_t Size, size_t MinimumCapacity)
+        {
+            size_t Step = std::min(Size, std::max<size_t>(MaxStepBytes / sizeof(T), 1));
+            size_t Grown = (Size <= detail::MaxCapacity<T>() - Step) ? Size + Step : detail::MaxCapacity<T>();
+            return std::max(Grown, MinimumCapacity);
+        }
+    };
+
+} // namespace blck
@@ -0,0 +1,280 @@
+#pragma once
+#include "benchmark_report.hpp"
+#include "growth_policy.hpp"
+#include "rotcev.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Rotcev_Profiling -tune: fits the growth_factors table of growth_policy.hpp
+// to the machine it runs on. For every sizeof(T) bucket of the table it fills
+// containers of a stand-in type in a few typical patterns with each candidate
+// factor, and scores fill time against peak buffer memory, both relative to
+// the best candidate. The winners are written as a header that replaces the
+// built-in table when the build names it in ROTCEV_GROWTH_FACTORS_HEADER.
+
+struct GrowthTuneOptions {
+    std::string output_path = "rotcev_tuned_growth.hpp";
+    // Share of the score given to time, the rest goes to peak memory
+    double time_weight = 0.5;
+    // Timed runs per candidate and pattern, the median is kept
+    int runs = 5;
+};
+
+// Growth by a factor chosen at run time, the candidate under test
+struct TuneGrowth {
+    static inline double factor = 2.0;
+
+    template <typename T>
+    static size_t next_capacity(size_t Size, size_t MinimumCapacity) {
+        return std::max(static_cast<size_t>(static_cast<double>(Size) * factor), MinimumCapacity);
+    }
+};
+
+// Live and peak bytes of the buffers handed out by TuneAllocator
+struct TuneMemory {
+    static inline size_t live = 0;
+    static inline size_t peak = 0;
+
+    static void add(size_t bytes) {
+        live += bytes;
+        peak = std::max(peak, live);
+    }
+};
+
+// malloc_allocator that keeps TuneMemory up to date; a realloc counts with
+// its new size only, it may well have grown in place
+template <typename T>
+struct TuneAllocator : blck::malloc_allocator<T> {
+    TuneAllocator() noexcept = default;
+
+    template <typename U>
+    TuneAllocator(const TuneAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        T* memory = blck::malloc_allocator<T>::allocate(count);
+        TuneMemory::add(count * sizeof(T));
+        return memory;
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept {
+        blck::malloc_allocator<T>::deallocate(ptr, count);
+        TuneMemory::live -= count * sizeof(T);
+    }
+
+    T* reallocate(T* ptr, size_t old_count, size_t new_count) {
+        T* memory = blck::malloc_allocator<T>::reallocate(ptr, old_count, new_count);
+        TuneMemory::live -= old_count * sizeof(T);
+        TuneMemory::add(new_count * sizeof(T));
+        return memory;
+    }
+};
+
+// Stand-in element of a sizeof bucket
+template <size_t Bytes>
+struct TunePayload {
+    unsigned char bytes[Bytes];
+};
+
+// Element counts to fill, one entry per container, and how the pushes are spread over them
+struct FillPattern {
+    const char* name;
+    std::vector<size_t> sizes;
+    bool interleaved;
+};
+
+// About budget_bytes of elements per pattern; sizes come from a fixed seed so
+// every candidate fills exactly the same containers
+inline std::vector<FillPattern> makeFillPatterns(size_t element_bytes, size_t budget_bytes) {
+    const size_t budget = std::max<size_t>(budget_bytes / element_bytes, 1);
+    std::mt19937_64 random(20240611);
+    std::vector<FillPattern> patterns;
+
+    // Many short-lived object members, sizes spread log-uniformly over 1..10000
+    FillPattern many{"many small", {}, false};
+    std::uniform_real_distribution<double> exponent(0.0, std::log(10000.0));
+    for (size_t total = 0; total < budget;) {
+        size_t size = static_cast<size_t>(std::exp(exponent(random)));
+        many.sizes.push_back(size);
+        total += size;
+    }
+    patterns.push_back(std::move(many));
+
+    // Containers growing side by side, no block can be extended in place
+    FillPattern interleaved{"interleaved", std::vector<size_t>(64, budget / 64 + 1), true};
+    patterns.push_back(std::move(interleaved));
+
+    // One large buffer, beyond the caches
+    patterns.push_back(FillPattern{"single large", {budget}, false});
+    return patterns;
+}
+
+struct FillResult {
+    double ns = 0.0;
+    size_t peak_bytes = 0;
+};
+
+template <typename T>
+FillResult runFill(const FillPattern& pattern) {
+    using Container = blck::rotcev<T, TuneAllocator<T>, TuneGrowth>;
+    std::vector<Container> containers(pattern.sizes.size());
+    T value{};
+    TuneMemory::live = 0;
+    TuneMemory::peak = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    if (pattern.interleaved) {
+        size_t longest = *std::max_element(pattern.sizes.begin(), pattern.sizes.end());
+        for (size_t i = 0; i < longest; i++) {
+            for (size_t c = 0; c < containers.size(); c++) {
+                if (i < pattern.sizes[c]) {
+                    value.bytes[0] = static_cast<unsigned char>(i);
+                    containers[c].push_back(value);
+                }
+            }
+        }
+    } else {
+        for (size_t c = 0; c < containers.size(); c++) {
+            for (size_t i = 0; i < pattern.sizes[c]; i++) {
+                value.bytes[0] = static_cast<unsigned char>(i);
+                containers[c].push_back(value);
+            }
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    FillResult result;
+    result.ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    result.peak_bytes = TuneMemory::peak;
+    return result;
+}
+
+// Tunes one bucket; returns the winning factor. current is the factor the
+// built-in table uses for the bucket, shown next to the candidates.
+template <typename T>
+double tuneBucket(const std::string& label, double current, const std::vector<double>& candidates,
+                  const GrowthTuneOptions& options) {
+    std::vector<FillPattern> patterns = makeFillPatterns(sizeof(T), size_t(32) << 20);
+    std::vector<double> factors = candidates;
+    if (std::find(factors.begin(), factors.end(), current) == factors.end()) {
+        factors.push_back(current);
+        std::sort(factors.begin(), factors.end());
+    }
+
+    // times[factor][pattern] over the runs; the rounds go over all factors
+    // in turn so drift of the machine hits every candidate alike
+    std::vector<std::vector<std::vector<double>>> times(
+        factors.size(), std::vector<std::vector<double>>(patterns.size()));
+    std::vector<std::vector<size_t>> peaks(factors.size(), std::vector<size_t>(patterns.size()));
+    for (int run = 0; run <= options.runs; run++) {
+        for (size_t f = 0; f < factors.size(); f++) {
+            TuneGrowth::factor = factors[f];
+            for (size_t p = 0; p < patterns.size(); p++) {
+                FillResult result = runFill<T>(patterns[p]);
+                // Round 0 only warms up the allocator and the caches
+                if (run > 0) times[f][p].push_back(result.ns);
+                peaks[f][p] = result.peak_bytes;
+            }
+        }
+    }
+
+    std::vector<double> best_time(patterns.size(), 0.0);
+    std::vector<double> best_peak(patterns.size(), 0.0);
+    std::vector<std::vector<double>> medians(factors.size(), std::vector<double>(patterns.size()));
+    for (size_t p = 0; p < patterns.size(); p++) {
+        for (size_t f = 0; f < factors.size(); f++) {
+            medians[f][p] = medianOf(times[f][p]);
+            double peak = static_cast<double>(peaks[f][p]);
+            best_time[p] = f == 0 ? medians[f][p] : std::min(best_time[p], medians[f][p]);
+            best_peak[p] = f == 0 ? peak : std::min(best_peak[p], peak);
+        }
+    }
+
+    std::cout << "\n" << label << " (sizeof " << sizeof(T) << "), time and peak memory relative to the best candidate,\n"
+              << "per pattern: ";
+    for (size_t p = 0; p < patterns.size(); p++) {
+        std::cout << (p ? ", " : "") << patterns[p].name;
+    }
+    std::cout << "\n" << std::setw(8) << "factor" << std::setw(26) << "time" << std::setw(26) << "peak memory"
+              << std::setw(10) << "score" << "\n";
+
+    double winner = factors.front();
+    double winner_score = 0.0;
+    for (size_t f = 0; f < factors.size(); f++) {
+        std::ostringstream time_text, peak_text;
+        double time_sum = 0.0, peak_sum = 0.0;
+        for (size_t p = 0; p < patterns.size(); p++) {
+            double time_rel = best_time[p] > 0 ? medians[f][p] / best_time[p] : 1.0;
+            double peak_rel = best_peak[p] > 0 ? static_cast<double>(peaks[f][p]) / best_peak[p] : 1.0;
+            time_sum += time_rel;
+            peak_sum += peak_rel;
+            time_text << std::fixed << std::setprecision(2) << (p ? " " : "") << time_rel;
+            peak_text << std::fixed << std::setprecision(2) << (p ? " " : "") << peak_rel;
+        }
+        double score = (options.time_weight * time_sum + (1.0 - options.time_weight) * peak_sum) /
+                       static_cast<double>(patterns.size());
+        if (f == 0 || score < winner_score) {
+            winner = factors[f];
+            winner_score = score;
+        }
+        std::cout << std::setw(8) << std::fixed << std::setprecision(2) << factors[f] << std::setw(26) << time_text.str()
+                  << std::setw(26) << peak_text.str() << std::setw(10) << std::setprecision(3) << score
+                  << (factors[f] == current ? "  (current)" : "") << "\n";
+    }
+    std::cout << "  -> " << std::setprecision(2) << winner << "\n";
+    return winner;
+}
+
+inline bool writeTunedGrowthHeader(const std::string& path, const std::array<double, 4>& factors,
+                                   const GrowthTuneOptions& options) {
+    std::ofstream out(path);
+    if (!out) return false;
+    BenchmarkEnvironment env = collectEnvironment();
+    long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    out << "#pragma once\n"
+        << "// Generated by Rotcev_Profiling -tune on " << env.timestamp << "\n"
+        << "// CPU: " << env.cpu_model << ", L2 " << (l2 > 0 ? l2 >> 10 : 0) << " KB, L3 " << (l3 > 0 ? l3 >> 10 : 0)
+        << " KB\n"
+        << "// Compiler: " << env.compiler << ", build type " << env.build_type << "\n"
+        << "// Score weights: time " << options.time_weight << ", peak memory " << 1.0 - options.time_weight << "\n"
+        << "// Configure with -DROTCEV_GROWTH_FACTORS_HEADER=<this file> to replace the built-in table\n"
+        << "#define ROTCEV_TUNED_GROWTH_FACTORS {" << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < factors.size(); i++) {
+        out << (i ? ", " : "") << factors[i];
+    }
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+inline int RunGrowthTuning(const GrowthTuneOptions& options) {
+    const std::vector<double> candidates = {1.25, 1.5, 1.75, 2.0, 2.5, 3.0, 4.0, 6.0, 8.0, 10.0};
+    const auto& current = blck::detail::growth_factors;
+    std::cout << "Growth factor tuning: " << candidates.size() << " candidates, " << options.runs
+              << " runs each, score = " << options.time_weight << " * time + " << 1.0 - options.time_weight
+              << " * peak memory\n";
+
+    std::array<double, 4> tuned = {
+        tuneBucket<TunePayload<4>>("tiny objects (1-8 bytes)", current[0], candidates, options),
+        tuneBucket<TunePayload<24>>("small objects (9-32 bytes)", current[1], candidates, options),
+        tuneBucket<TunePayload<64>>("medium objects (33-128 bytes)", current[2], candidates, options),
+        tuneBucket<TunePayload<256>>("large objects (129+ bytes)", current[3], candidates, options)};
+
+    if (!writeTunedGrowthHeader(options.output_path, tuned, options)) {
+        std::cerr << "could not write " << options.output_path << std::endl;
+        return 1;
+    }
+    std::cout << "\nwrote " << options.output_path << ", configure with -DROTCEV_GROWTH_FACTORS_HEADER="
+              << options.output_path << " to build with it" << std::endl;
+    return 0;
+}
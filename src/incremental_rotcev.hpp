@@ -0,0 +1,430 @@
+#pragma once
+#include "rotcev.hpp"
+#include "segmented_rotcev.hpp"
+
+namespace blck
+{
+    // rotcev variant that spreads each relocation over the following push_backs,
+    // like incremental rehashing in a hash table.
+    // When the buffer is full a new one is allocated, but the old elements stay
+    // where they are; every later push_back relocates a bounded batch of them.
+    // The batch is sized so the old buffer is always empty before the new one
+    // fills up, which makes push_back O(1) in the worst case (one allocation
+    // plus a fixed number of element moves).
+    // While a migration is pending, operator[] checks which buffer holds the
+    // index (one extra compare) and the elements are not contiguous, so
+    // iterators are index based. data() finishes the migration first.
+    // Migration runs inside push_back after the new element is built, so it
+    // must not throw; element types whose move constructor may throw (and that
+    // are not trivially relocatable) are relocated in one go when the buffer
+    // grows instead, like rotcev does.
+    template <typename T, typename Alloc = malloc_allocator<T>, typename GrowthPolicy = default_growth, size_t MigrationStep = 8>
+    class incremental_rotcev
+    {
+        static_assert(MigrationStep > 0, "incremental_rotcev has to migrate at least one element per push_back");
+
+    public:
+        using ValueType = T;
+        using AllocatorType = Alloc;
+        using GrowthPolicyType = GrowthPolicy;
+        using Iterator = SegmentedIterator<incremental_rotcev<T, Alloc, GrowthPolicy, MigrationStep>>;
+        using ConstIterator = SegmentedIterator<incremental_rotcev<T, Alloc, GrowthPolicy, MigrationStep>, true>;
+        using ReverseIterator = std::reverse_iterator<Iterator>;
+        using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+        using reverse_iterator = ReverseIterator;
+        using const_reverse_iterator = ConstReverseIterator;
+    private:
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+        static constexpr bool IncrementalMigration = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+        // Elements [m_Migrated, m_OldCount) still live in m_Old, everything else in m_Start
+        T *SlotFor(size_t Index) const noexcept
+        {
+            return (Index - m_Migrated < m_OldCount - m_Migrated) ? m_Old + Index : m_Start + Index;
+        }
+
+        void ReleaseOld() noexcept
+        {
+            if (m_Old)
+            {
+                AllocTraits::deallocate(m_Allocator, m_Old, m_OldCapacity);
+            }
+            m_Old = nullptr;
+            m_OldCapacity = 0;
+            m_OldCount = 0;
+            m_Migrated = 0;
+        }
+
+        // Relocates up to Count pending elements into the new buffer
+        void Migrate(size_t Count) noexcept
+        {
+            static_assert(IncrementalMigration, "only element types that relocate without throwing migrate incrementally");
+            size_t Pending = m_OldCount - m_Migrated;
+            size_t Batch = Count < Pending ? Count : Pending;
+            detail::RelocateElements(m_Allocator, m_Start + m_Migrated, m_Old + m_Migrated, Batch);
+            m_Migrated += Batch;
+            if (m_Migrated == m_OldCount)
+            {
+                ReleaseOld();
+            }
+        }
+
+        // Switches to a buffer of NewCapacity, leaving the elements behind for Migrate()
+        void BeginMigration(size_t NewCapacity)
+        {
+            finish_migration();
+            T *NewStart = AllocTraits::allocate(m_Allocator, NewCapacity);
+            if constexpr (!IncrementalMigration)
+            {
+                detail::RelocateElements(m_Allocator, NewStart, m_Start, m_Size);
+                if (m_Start)
+                {
+                    AllocTraits::deallocate(m_Allocator, m_Start, m_Capacity);
+                }
+            }
+            else if (m_Size > 0)
+            {
+                m_Old = m_Start;
+                m_OldCapacity = m_Capacity;
+                m_OldCount = m_Size;
+                m_Migrated = 0;
+                // Enough per push_back to be done before the new buffer is full;
+                // the push_back that triggered the growth does not migrate
+                size_t Pushes = NewCapacity - m_Size - 1;
+                size_t Needed = Pushes ? (m_Size + Pushes - 1) / Pushes : m_Size;
+                m_Step = Needed > MigrationStep ? Needed : MigrationStep;
+            }
+            else if (m_Start)
+            {
+                AllocTraits::deallocate(m_Allocator, m_Start, m_Capacity);
+            }
+            m_Start = NewStart;
+            m_Capacity = NewCapacity;
+        }
+
+        template <typename... Args>
+        inline T &AllocateNewSpace(Args &&...Arguments)
+        {
+            if (m_Capacity < m_Size + 1)
+            {
+                // Build the element first, the arguments may live inside the container
+                T Copy(std::forward<Args>(Arguments)...);
+                BeginMigration(GrowthPolicy::template next_capacity<T>(m_Size, m_Size + 1));
+                AllocTraits::construct(m_Allocator, m_Start + m_Size, std::move(Copy));
+            }
+            else
+            {
+                AllocTraits::construct(m_Allocator, m_Start + m_Size, std::forward<Args>(Arguments)...);
+                if constexpr (IncrementalMigration)
+                {
+                    if (m_Old)
+                    {
+                        Migrate(m_Step);
+                    }
+                }
+            }
+            return m_Start[m_Size++];
+        }
+
+        void DestroyRange(size_t From, size_t To) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (size_t i = From; i < To; i++)
+                {
+                    AllocTraits::destroy(m_Allocator, SlotFor(i));
+                }
+            }
+        }
+
+        void ReleaseBuffer() noexcept
+        {
+            DestroyRange(0, m_Size);
+            ReleaseOld();
+            if (m_Start)
+            {
+                AllocTraits::deallocate(m_Allocator, m_Start, m_Capacity);
+            }
+            m_Start = nullptr;
+            m_Size = 0;
+            m_Capacity = 0;
+        }
+
+        void CopyFrom(const incremental_rotcev &Other)
+        {
+            if (Other.m_Size == 0)
+            {
+                return;
+            }
+            m_Start = AllocTraits::allocate(m_Allocator, Other.m_Size);
+            m_Capacity = Other.m_Size;
+            for (; m_Size < Other.m_Size; m_Size++)
+            {
+                AllocTraits::construct(m_Allocator, m_Start + m_Size, Other[m_Size]);
+            }
+        }
+
+        void StealFrom(incremental_rotcev &Other) noexcept
+        {
+            m_Start = Other.m_Start;
+            m_Size = Other.m_Size;
+            m_Capacity = Other.m_Capacity;
+            m_Old = Other.m_Old;
+            m_OldCapacity = Other.m_OldCapacity;
+            m_OldCount = Other.m_OldCount;
+            m_Migrated = Other.m_Migrated;
+            m_Step = Other.m_Step;
+            Other.m_Start = nullptr;
+            Other.m_Size = 0;
+            Other.m_Capacity = 0;
+            Other.m_Old = nullptr;
+            Other.m_OldCapacity = 0;
+            Other.m_OldCount = 0;
+            Other.m_Migrated = 0;
+        }
+
+    public:
+        incremental_rotcev()
+        {}
+        explicit incremental_rotcev(const Alloc &Allocator)
+            : m_Allocator(Allocator)
+        {}
+        ~incremental_rotcev()
+        {
+            ReleaseBuffer();
+        }
+
+        incremental_rotcev(const incremental_rotcev &other)
+            : m_Allocator(AllocTraits::select_on_container_copy_construction(other.m_Allocator))
+        {
+            CopyFrom(other);
+        }
+
+        incremental_rotcev(incremental_rotcev &&other) noexcept
+            : m_Allocator(std::move(other.m_Allocator))
+        {
+            StealFrom(other);
+        }
+
+        incremental_rotcev &operator=(const incremental_rotcev &other)
+        {
+            if (this != &other)
+            {
+                ReleaseBuffer();
+                if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+                {
+                    m_Allocator = other.m_Allocator;
+                }
+                CopyFrom(other);
+            }
+            return *this;
+        }
+
+        incremental_rotcev &operator=(incremental_rotcev &&other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            {
+                ReleaseBuffer();
+                m_Allocator = std::move(other.m_Allocator);
+                StealFrom(other);
+            }
+            else if (m_Allocator == other.m_Allocator)
+            {
+                ReleaseBuffer();
+                StealFrom(other);
+            }
+            else
+            {
+                // other's buffers have to go back to other's allocator; move the elements over one by one
+                clear();
+                reserve(other.m_Size);
+                for (size_t i = 0; i < other.m_Size; i++)
+                {
+                    AllocTraits::construct(m_Allocator, m_Start + i, std::move(other[i]));
+                    m_Size++;
+                }
+                other.clear();
+            }
+            return *this;
+        }
+
+        Iterator begin() noexcept
+        {
+            return Iterator(this, 0);
+        }
+        Iterator end() noexcept
+        {
+            return Iterator(this, m_Size);
+        }
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(this, 0);
+        }
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator(this, m_Size);
+        }
+        ConstIterator cbegin() const noexcept
+        {
+            return ConstIterator(this, 0);
+        }
+        ConstIterator cend() const noexcept
+        {
+            return ConstIterator(this, m_Size);
+        }
+        ReverseIterator rbegin() noexcept
+        {
+            return ReverseIterator(end());
+        }
+        ReverseIterator rend() noexcept
+        {
+            return ReverseIterator(begin());
+        }
+        ConstReverseIterator rbegin() const noexcept
+        {
+            return ConstReverseIterator(end());
+        }
+        ConstReverseIterator rend() const noexcept
+        {
+            return ConstReverseIterator(begin());
+        }
+
+        void push_back(const T &Value)
+        {
+            this->AllocateNewSpace(Value);
+        }
+
+        void push_back(T &&Value)
+        {
+            this->AllocateNewSpace(std::move(Value));
+        }
+
+        template <typename... Args>
+        T &emplace_back(Args &&...Arguments)
+        {
+            return this->AllocateNewSpace(std::forward<Args>(Arguments)...);
+        }
+
+        inline void pop_back() noexcept
+        {
+            if (m_Size == 0)
+            {
+                return;
+            }
+            --m_Size;
+            AllocTraits::destroy(m_Allocator, SlotFor(m_Size));
+            if (m_Size < m_OldCount)
+            {
+                // Popped into the not yet migrated part
+                m_OldCount = m_Size;
+                if (m_Migrated >= m_OldCount)
+                {
+                    ReleaseOld();
+                }
+            }
+        }
+
+        void clear() noexcept
+        {
+            DestroyRange(0, m_Size);
+            ReleaseOld();
+            m_Size = 0;
+        }
+
+        T &operator[](size_t Index) noexcept
+        {
+            return *SlotFor(Index);
+        }
+
+        const T &operator[](size_t Index) const noexcept
+        {
+            return *SlotFor(Index);
+        }
+
+        inline size_t size() const noexcept
+        {
+            return m_Size;
+        }
+
+        inline size_t capacity() const noexcept
+        {
+            return m_Capacity;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+        // True while part of the elements still sit in the previous buffer
+        inline bool migrating() const noexcept
+        {
+            return m_Old != nullptr;
+        }
+
+        // Relocates every pending element now (one-shot, like rotcev)
+        void finish_migration() noexcept
+        {
+            if constexpr (IncrementalMigration)
+            {
+                if (m_Old)
+                {
+                    Migrate(m_OldCount - m_Migrated);
+                }
+            }
+        }
+
+        // Contiguous view of the elements, finishes a pending migration first
+        inline T *data() noexcept
+        {
+            finish_migration();
+            return m_Start;
+        }
+
+        // Growing through reserve() also migrates incrementally
+        void reserve(size_t NewCapacity)
+        {
+            if (NewCapacity > m_Capacity)
+            {
+                BeginMigration(NewCapacity);
+            }
+        }
+
+        Alloc get_allocator() const noexcept
+        {
+            return m_Allocator;
+        }
+
+    private:
+        T *m_Start = nullptr;
+        size_t m_Size = 0;
+        size_t m_Capacity = 0;
+
+        // Previous buffer while a migration is in flight
+        T *m_Old = nullptr;
+        size_t m_OldCapacity = 0;
+        size_t m_OldCount = 0;
+        size_t m_Migrated = 0;
+        size_t m_Step = MigrationStep;
+
+        [[no_unique_address]] Alloc m_Allocator;
+    };
+
+} // namespace blck
@@ -0,0 +1,312 @@
+#pragma once
+#include "rotcev.hpp"
+#include <initializer_list>
+
+namespace blck
+{
+    // Non-owning view of one row of a jagged_rotcev. Pointer based, so it is
+    // invalidated like a rotcev iterator whenever the container grows.
+    template <typename T>
+    class jagged_row
+    {
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using size_type = size_t;
+        using reference = T &;
+        using pointer = T *;
+        using iterator = T *;
+
+        jagged_row() noexcept
+        {}
+        jagged_row(T *Start, size_t Size) noexcept
+            : m_Start(Start), m_Size(Size)
+        {}
+
+        // row -> const row
+        template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+        jagged_row(const jagged_row<U> &Other) noexcept
+            : m_Start(Other.data()), m_Size(Other.size())
+        {}
+
+        T *begin() const noexcept
+        {
+            return m_Start;
+        }
+        T *end() const noexcept
+        {
+            return m_Start + m_Size;
+        }
+
+        T &operator[](size_t Index) const noexcept
+        {
+            return m_Start[Index];
+        }
+
+        inline T *data() const noexcept
+        {
+            return m_Start;
+        }
+
+        inline size_t size() const noexcept
+        {
+            return m_Size;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+    private:
+        T *m_Start = nullptr;
+        size_t m_Size = 0;
+    };
+
+    // Replacement for rotcev<rotcev<T>> in CSR layout: all rows share one
+    // contiguous values buffer and a second buffer records where each row starts.
+    // The last row ends at size(), so appending to it only touches the values.
+    // Building N rows costs two growing allocations instead of N + 1, and
+    // walking every element is a linear scan instead of N pointer chases.
+    // Only the last row can grow (push_back/emplace_back append to it); rows
+    // are read through jagged_row views, and begin()/end() iterate over all
+    // elements of all rows in order.
+    template <typename T, typename Alloc = malloc_allocator<T>, typename GrowthPolicy = default_growth>
+    class jagged_rotcev
+    {
+    public:
+        using ValueType = T;
+        using AllocatorType = Alloc;
+        using GrowthPolicyType = GrowthPolicy;
+        using Iterator = RotcevIterator<jagged_rotcev<T, Alloc, GrowthPolicy>>;
+        using ConstIterator = RotcevIterator<jagged_rotcev<T, Alloc, GrowthPolicy>, true>;
+        using Row = jagged_row<T>;
+        using ConstRow = jagged_row<const T>;
+
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+    private:
+        using OffsetAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<size_t>;
+
+        size_t RowEnd(size_t RowIndex) const noexcept
+        {
+            return RowIndex + 1 < m_Starts.size() ? m_Starts[RowIndex + 1] : m_Values.size();
+        }
+
+    public:
+        jagged_rotcev()
+        {}
+        explicit jagged_rotcev(const Alloc &Allocator)
+            : m_Values(Allocator), m_Starts(OffsetAlloc(Allocator))
+        {}
+
+        Iterator begin() noexcept
+        {
+            return Iterator(m_Values.data());
+        }
+        Iterator end() noexcept
+        {
+            return Iterator(m_Values.data() + m_Values.size());
+        }
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(m_Values.data());
+        }
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator(m_Values.data() + m_Values.size());
+        }
+        ConstIterator cbegin() const noexcept
+        {
+            return begin();
+        }
+        ConstIterator cend() const noexcept
+        {
+            return end();
+        }
+
+        // Starts a new, empty last row
+        void push_row()
+        {
+            m_Starts.push_back(m_Values.size());
+        }
+
+        template <typename InputIt>
+        void push_row(InputIt First, InputIt Last)
+        {
+            push_row();
+            m_Values.append(First, Last);
+        }
+
+        void push_row(std::initializer_list<T> Values)
+        {
+            push_row(Values.begin(), Values.end());
+        }
+
+        template <typename Range>
+        void push_row_range(const Range &Source)
+        {
+            push_row();
+            m_Values.append_range(Source);
+        }
+
+        // Drops the last row and its elements
+        void pop_row() noexcept
+        {
+            if (m_Starts.empty())
+            {
+                return;
+            }
+            size_t NewSize = m_Starts[m_Starts.size() - 1];
+            m_Starts.pop_back();
+            while (m_Values.size() > NewSize)
+            {
+                m_Values.pop_back();
+            }
+        }
+
+        // Appends to the last row; a first row is started when there is none
+        void push_back(const T &Value)
+        {
+            emplace_back(Value);
+        }
+
+        void push_back(T &&Value)
+        {
+            emplace_back(std::move(Value));
+        }
+
+        template <typename... Args>
+        T &emplace_back(Args &&...Arguments)
+        {
+            if (m_Starts.empty())
+            {
+                push_row();
+            }
+            return m_Values.emplace_back(std::forward<Args>(Arguments)...);
+        }
+
+        // Appends [First, Last) to the last row
+        template <typename InputIt>
+        void append(InputIt First, InputIt Last)
+        {
+            if (m_Starts.empty())
+            {
+                push_row();
+            }
+            m_Values.append(First, Last);
+        }
+
+        Row row(size_t RowIndex) noexcept
+        {
+            size_t Begin = m_Starts[RowIndex];
+            return Row(m_Values.data() + Begin, RowEnd(RowIndex) - Begin);
+        }
+
+        ConstRow row(size_t RowIndex) const noexcept
+        {
+            size_t Begin = m_Starts[RowIndex];
+            return ConstRow(m_Values.data() + Begin, RowEnd(RowIndex) - Begin);
+        }
+
+        Row operator[](size_t RowIndex) noexcept
+        {
+            return row(RowIndex);
+        }
+
+        ConstRow operator[](size_t RowIndex) const noexcept
+        {
+            return row(RowIndex);
+        }
+
+        Row back_row() noexcept
+        {
+            return row(m_Starts.size() - 1);
+        }
+
+        inline size_t row_size(size_t RowIndex) const noexcept
+        {
+            return RowEnd(RowIndex) - m_Starts[RowIndex];
+        }
+
+        inline size_t row_count() const noexcept
+        {
+            return m_Starts.size();
+        }
+
+        // Total number of elements over all rows
+        inline size_t size() const noexcept
+        {
+            return m_Values.size();
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Starts.empty();
+        }
+
+        // All elements, row after row
+        inline T *data() noexcept
+        {
+            return m_Values.data();
+        }
+
+        inline const T *data() const noexcept
+        {
+            return m_Values.data();
+        }
+
+        // Start offset of every row into data()
+        inline const size_t *row_starts() const noexcept
+        {
+            return m_Starts.data();
+        }
+
+        void reserve(size_t Rows, size_t Values)
+        {
+            m_Starts.reserve(Rows);
+            m_Values.reserve(Values);
+        }
+
+        void shrink_to_fit()
+        {
+            m_Starts.shrink_to_fit();
+            m_Values.shrink_to_fit();
+        }
+
+        void clear() noexcept
+        {
+            m_Values.clear();
+            m_Starts.clear();
+        }
+
+        void swap(jagged_rotcev &Other) noexcept
+        {
+            m_Values.swap(Other.m_Values);
+            m_Starts.swap(Other.m_Starts);
+        }
+
+        Alloc get_allocator() const noexcept
+        {
+            return m_Values.get_allocator();
+        }
+
+    private:
+        rotcev<T, Alloc, GrowthPolicy> m_Values;
+        rotcev<size_t, OffsetAlloc, GrowthPolicy> m_Starts;
+    };
+
+    template <typename T, typename Alloc, typename GrowthPolicy>
+    inline void swap(jagged_rotcev<T, Alloc, GrowthPolicy> &Lhs, jagged_rotcev<T, Alloc, GrowthPolicy> &Rhs) noexcept
+    {
+        Lhs.swap(Rhs);
+    }
+
+} // namespace blck
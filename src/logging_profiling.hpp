@@ -1,5 +1,30 @@
 #pragma once
 #include "rotcev.hpp"
+#include "monotonic_arena.hpp"
+#include "small_rotcev.hpp"
+#include "vm_allocator.hpp"
+#include "rotcev_simd.hpp"
+#include "parallel.hpp"
+#include "rotcev_concurrent.hpp"
+#include "segmented_rotcev.hpp"
+#include "incremental_rotcev.hpp"
+#include "mapped_rotcev.hpp"
+#include "rotcev_io.hpp"
+#include "rotcev_soa.hpp"
+#include "benchmark_harness.hpp"
+#include "benchmark_report.hpp"
+#include "perf_counters.hpp"
+#include "scaling_benchmark.hpp"
+#include <filesystem>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -7,6 +32,10 @@
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <memory>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
 
 // Global variables to track performance statistics
 struct PerformanceStats {
@@ -77,8 +106,43 @@ struct PerformanceStats {
     std::map<std::string, int> type_tests;
     std::map<std::string, long long> type_rotcev_total;
     std::map<std::string, long long> type_std_total;
+
+    // Every printResult() with the section it ran in, for JSON/CSV output
+    std::vector<BenchmarkRecord> records;
+    std::string current_section;
+
+    // perf counters of the case being measured, indexed by CaseSide; the
+    // next printResult() takes them over
+    blck::bench::counter_values counter_start[2];
+    blck::bench::counter_values case_counters[2];
+    long long case_elements[2] = {0, 0};
 } g_stats;
 
+// Open while -test --counters runs, null otherwise
+std::unique_ptr<blck::bench::perf_counters> g_perf;
+
+enum class CaseSide { Rotcev = 0, Std = 1 };
+
+// Clock reads around the measured code of one side of a case. With counters
+// enabled they also read the perf counters, outside the timed interval, and
+// add the difference to the current case.
+std::chrono::high_resolution_clock::time_point caseStart(CaseSide side) {
+    if (g_perf) {
+        g_stats.counter_start[static_cast<int>(side)] = g_perf->read();
+    }
+    return std::chrono::high_resolution_clock::now();
+}
+
+std::chrono::high_resolution_clock::time_point caseStop(CaseSide side, long long elements = 0) {
+    auto now = std::chrono::high_resolution_clock::now();
+    if (g_perf) {
+        int index = static_cast<int>(side);
+        g_stats.case_counters[index] += g_perf->read() - g_stats.counter_start[index];
+        g_stats.case_elements[index] += elements;
+    }
+    return now;
+}
+
 // Test class for non-trivial object testing
 class TestObject {
 private:
@@ -136,6 +200,20 @@ public:
     size_t getSize() const { return size; }
 };
 
+// TestObject holds no pointers into itself, so it relocates bitwise whenever its std::string member does
+namespace blck {
+    template <>
+    struct is_trivially_relocatable<TestObject> : is_trivially_relocatable<std::string> {};
+}
+
+// Six field record for the structure-of-arrays comparison
+struct ParticleRecord {
+    double x, y, z;
+    double mass;
+    int id;
+    int flags;
+};
+
 // Utility functions for formatting
 void printHeader(const std::string& title) {
     std::cout << "\n" << std::string(60, '=') << "\n";
@@ -147,6 +225,7 @@ void printSubHeader(const std::string& subtitle) {
     std::cout << "\n" << std::string(40, '-') << "\n";
     std::cout << "  " << subtitle << "\n";
     std::cout << std::string(40, '-') << "\n";
+    g_stats.current_section = subtitle;
 }
 
 void printResult(const std::string& test_name, long long rotcev_time, long long vector_time, const std::string& type_name = "") {
@@ -157,6 +236,24 @@ void printResult(const std::string& test_name, long long rotcev_time, long long
     
     // Store all results for detailed analysis - spike detection will be done later
     g_stats.all_results.push_back({test_name, {rotcev_time, vector_time}});
+    BenchmarkRecord record;
+    record.section = g_stats.current_section;
+    record.name = test_name;
+    record.type = type_name;
+    record.size = leadingNumber(test_name);
+    record.rotcev_ns = rotcev_time;
+    record.std_ns = vector_time;
+    if (g_perf) {
+        // Without a count from the case itself the number in its name is the element count
+        long long fallback = std::max(1LL, elementCount(test_name));
+        record.rotcev_counters = g_stats.case_counters[0];
+        record.std_counters = g_stats.case_counters[1];
+        record.rotcev_elements = g_stats.case_elements[0] ? g_stats.case_elements[0] : fallback;
+        record.std_elements = g_stats.case_elements[1] ? g_stats.case_elements[1] : fallback;
+        g_stats.case_counters[0] = g_stats.case_counters[1] = blck::bench::counter_values();
+        g_stats.case_elements[0] = g_stats.case_elements[1] = 0;
+    }
+    g_stats.records.push_back(record);
     
     // Track statistics
     g_stats.total_tests++;
@@ -203,21 +300,192 @@ void printResult(const std::string& test_name, long long rotcev_time, long long
     std::cout << "\n";
 }
 
-// Template function for timing single operations
+template<typename Container>
+struct IsStdVector : std::false_type {};
+
+template<typename T, typename Alloc>
+struct IsStdVector<std::vector<T, Alloc>> : std::true_type {};
+
+// Times one operation with the benchmark harness and returns its median in ns.
+// The operation is picked before measuring and repeated over calibrated
+// samples, so the result is no longer a single clock read.
 template<typename T, typename Container>
 long long timeOperation(Container& container, T value, const std::string& operation) {
-    auto start = std::chrono::high_resolution_clock::now();
-    
+    blck::bench::options options;
+    options.samples = 15;
+    options.min_sample_time = std::chrono::microseconds(200);
+
+    const CaseSide side = IsStdVector<Container>::value ? CaseSide::Std : CaseSide::Rotcev;
+    blck::bench::result result;
     if (operation == "push_back") {
+        result = blck::bench::run(operation, [] { return Container(); }, [&value](Container& fresh) {
+            fresh.push_back(value);
+        }, options);
+        // Keep the old side effect, later access tests read container[0]
         container.push_back(value);
+        if (g_perf) {
+            // Counters over one more sample, the harness samples are not observable
+            Container fresh;
+            caseStart(side);
+            for (size_t i = 0; i < result.iterations; ++i) {
+                fresh.push_back(value);
+            }
+            caseStop(side, static_cast<long long>(result.iterations));
+            blck::bench::do_not_optimize(fresh);
+        }
     } else if (operation == "access") {
-        // For access, we need at least one element - check if we can access [0]
-        auto ref = container[0]; // This will work if container has elements
-        (void)ref; // suppress unused variable warning
+        result = blck::bench::run(operation, [&container] {
+            const auto& ref = container[0];
+            blck::bench::do_not_optimize(ref);
+        }, options);
+        if (g_perf) {
+            caseStart(side);
+            for (size_t i = 0; i < result.iterations; ++i) {
+                const auto& ref = container[0];
+                blck::bench::do_not_optimize(ref);
+            }
+            caseStop(side, static_cast<long long>(result.iterations));
+        }
+    }
+    // This report prints whole ns; Rotcev_Benchmark has the sub-ns medians
+    return std::max(1LL, static_cast<long long>(std::llround(result.median_ns)));
+}
+
+// Process and malloc memory figures for the memory efficiency section
+struct MemoryUsage {
+    long long rss_bytes = 0;   // resident set, /proc/self/statm
+    long long heap_in_use = 0; // bytes malloc has handed out, arena and mmapped chunks (mallinfo2)
+    long long heap_free = 0;   // free bytes malloc keeps in its bins (malloc_info fast + rest)
+    long long heap_system = 0; // bytes malloc's arenas got from the system (malloc_info current)
+};
+
+// size="..." of the last <Tag type="Type" .../> in malloc_info output, the
+// per-arena entries come first and the totals last
+inline long long mallocInfoSize(const std::string& xml, const std::string& tag, const std::string& type) {
+    size_t pos = xml.rfind("<" + tag + " type=\"" + type + "\"");
+    if (pos == std::string::npos) return 0;
+    pos = xml.find("size=\"", pos);
+    if (pos == std::string::npos) return 0;
+    return std::strtoll(xml.c_str() + pos + 6, nullptr, 10);
+}
+
+inline MemoryUsage readMemoryUsage() {
+    MemoryUsage usage;
+    std::ifstream statm("/proc/self/statm");
+    long long total_pages = 0, resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        usage.rss_bytes = resident_pages * sysconf(_SC_PAGESIZE);
+    }
+    struct mallinfo2 info = mallinfo2();
+    usage.heap_in_use = static_cast<long long>(info.uordblks + info.hblkhd);
+
+    char* buffer = nullptr;
+    size_t length = 0;
+    if (FILE* stream = open_memstream(&buffer, &length)) {
+        malloc_info(0, stream);
+        fclose(stream);
+        std::string xml(buffer, length);
+        usage.heap_free = mallocInfoSize(xml, "total", "fast") + mallocInfoSize(xml, "total", "rest");
+        usage.heap_system = mallocInfoSize(xml, "system", "current");
+    }
+    free(buffer);
+    return usage;
+}
+
+// What Count containers of FinalSize elements each, built by push_back,
+// cost, measured with the containers alive
+struct MemoryCost {
+    double capacity_ratio = 0;     // sum of capacities / sum of sizes
+    long long requested_bytes = 0; // capacity * sizeof(T) over all outer buffers
+    long long heap_bytes = 0;      // growth of malloc's in-use bytes, includes what the elements own
+    long long rss_bytes = 0;       // growth of the resident set
+    // Free bytes the build left in malloc's bins (outgrown buffers nothing
+    // reuses), per byte in use
+    double fragmentation = 0;
+};
+
+template<typename Container, typename Make>
+MemoryCost buildAndMeasure(size_t count, size_t final_size, Make& make) {
+    MemoryCost cost;
+    std::vector<Container> containers;
+    containers.reserve(count);
+    malloc_trim(0);
+    MemoryUsage before = readMemoryUsage();
+    for (size_t c = 0; c < count; ++c) {
+        containers.emplace_back();
+        Container& container = containers.back();
+        for (size_t i = 0; i < final_size; ++i) {
+            container.push_back(make(i));
+        }
+    }
+    MemoryUsage after = readMemoryUsage();
+
+    size_t capacity = 0;
+    for (const Container& container : containers) capacity += container.capacity();
+    cost.capacity_ratio = static_cast<double>(capacity) / static_cast<double>(count * final_size);
+    cost.requested_bytes = static_cast<long long>(capacity * sizeof(typename Container::value_type));
+    cost.heap_bytes = after.heap_in_use - before.heap_in_use;
+    cost.rss_bytes = after.rss_bytes - before.rss_bytes;
+    long long stranded = std::max(0LL, after.heap_free - before.heap_free);
+    cost.fragmentation = cost.heap_bytes > 0 ? static_cast<double>(stranded) / static_cast<double>(cost.heap_bytes) : 0.0;
+    return cost;
+}
+
+// Runs the measurement in a forked child: both containers start from the same
+// heap, and neither reuses memory the other one freed. Falls back to measuring
+// here when fork is not possible.
+template<typename Container, typename Make>
+MemoryCost measureContainerMemory(size_t count, size_t final_size, Make make) {
+    int channel[2];
+    if (pipe(channel) == 0) {
+        std::cout.flush();
+        pid_t child = fork();
+        if (child == 0) {
+            close(channel[0]);
+            MemoryCost cost = buildAndMeasure<Container>(count, final_size, make);
+            ssize_t written = write(channel[1], &cost, sizeof(cost));
+            _exit(written == static_cast<ssize_t>(sizeof(cost)) ? 0 : 1);
+        }
+        close(channel[1]);
+        if (child > 0) {
+            MemoryCost cost;
+            ssize_t received = read(channel[0], &cost, sizeof(cost));
+            close(channel[0]);
+            int status = 0;
+            while (waitpid(child, &status, 0) < 0 && errno == EINTR) {}
+            if (received == static_cast<ssize_t>(sizeof(cost))) return cost;
+        } else {
+            close(channel[0]);
+        }
+    }
+    return buildAndMeasure<Container>(count, final_size, make);
+}
+
+// One memory efficiency row per final size: rotcev (with Growth) against std::vector.
+// element_bytes estimates what an element owns, including its own heap, and
+// keeps every row near the same footprint.
+template<typename T, typename Growth = blck::default_growth, typename Make>
+void compareContainerMemory(const std::string& label, size_t element_bytes, Make make) {
+    const size_t budget_bytes = size_t(32) << 20;
+    const size_t max_containers = 20000;
+    for (size_t final_size : {size_t(7), size_t(50), size_t(333), size_t(5000), size_t(75000), size_t(1200000)}) {
+        // The biggest rows would take hundreds of MB for the heavy types
+        if (final_size * element_bytes > 2 * budget_bytes) continue;
+        size_t count = std::min(max_containers, std::max<size_t>(1, budget_bytes / (final_size * element_bytes)));
+
+        MemoryCost rotcev_cost = measureContainerMemory<blck::rotcev<T, blck::malloc_allocator<T>, Growth>>(count, final_size, make);
+        MemoryCost std_cost = measureContainerMemory<std::vector<T>>(count, final_size, make);
+
+        auto megabytes = [](long long bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+        std::stringstream row;
+        row << count << "x" << final_size;
+        std::cout << std::left << std::setw(12) << label << std::setw(14) << row.str() << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(7) << rotcev_cost.capacity_ratio << " /" << std::setw(5) << std_cost.capacity_ratio
+                  << std::setprecision(1) << std::setw(9) << megabytes(rotcev_cost.requested_bytes) << " /" << std::setw(7) << megabytes(std_cost.requested_bytes)
+                  << std::setw(9) << megabytes(rotcev_cost.heap_bytes) << " /" << std::setw(7) << megabytes(std_cost.heap_bytes)
+                  << std::setw(9) << megabytes(rotcev_cost.rss_bytes) << " /" << std::setw(7) << megabytes(std_cost.rss_bytes)
+                  << std::setw(7) << 100.0 * rotcev_cost.fragmentation << "% /" << std::setw(5) << 100.0 * std_cost.fragmentation << "%\n";
     }
-    
-    auto end = std::chrono::high_resolution_clock::now();
-    return (end - start).count();
 }
 
 // Template function for bulk operations
@@ -235,18 +503,18 @@ void testBulkOperations(const std::string& type_name, const std::vector<T>& test
         std::vector<T> std_container;
         
         // Time bulk push_back operations
-        auto start_rotcev = std::chrono::high_resolution_clock::now();
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
         for (size_t i = 0; i < bulk_size; ++i) {
             T item = test_data[i % test_data.size()]; // Make a copy to avoid const issues
             rotcev_container.push_back(item);
         }
-        auto end_rotcev = std::chrono::high_resolution_clock::now();
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
         
-        auto start_std = std::chrono::high_resolution_clock::now();
+        auto start_std = caseStart(CaseSide::Std);
         for (size_t i = 0; i < bulk_size; ++i) {
             std_container.push_back(test_data[i % test_data.size()]);
         }
-        auto end_std = std::chrono::high_resolution_clock::now();
+        auto end_std = caseStop(CaseSide::Std);
         
         long long rotcev_time = (end_rotcev - start_rotcev).count();
         long long std_time = (end_std - start_std).count();
@@ -257,19 +525,19 @@ void testBulkOperations(const std::string& type_name, const std::vector<T>& test
         
         // Test bulk access operations
         if (bulk_size <= 100) { // Only for smaller sizes to avoid too much output
-            start_rotcev = std::chrono::high_resolution_clock::now();
+            start_rotcev = caseStart(CaseSide::Rotcev);
             for (size_t i = 0; i < bulk_size; ++i) {
                 auto ref = rotcev_container[i];
                 (void)ref;
             }
-            end_rotcev = std::chrono::high_resolution_clock::now();
+            end_rotcev = caseStop(CaseSide::Rotcev);
             
-            start_std = std::chrono::high_resolution_clock::now();
+            start_std = caseStart(CaseSide::Std);
             for (size_t i = 0; i < bulk_size; ++i) {
                 auto ref = std_container[i];
                 (void)ref;
             }
-            end_std = std::chrono::high_resolution_clock::now();
+            end_std = caseStop(CaseSide::Std);
             
             rotcev_time = (end_rotcev - start_rotcev).count();
             std_time = (end_std - start_std).count();
@@ -281,6 +549,143 @@ void testBulkOperations(const std::string& type_name, const std::vector<T>& test
     }
 }
 
+// Memory efficiency rows (-memory). Each figure is measured in a process
+// forked from this one, which should have done little else: an allocator
+// that already holds free memory from earlier work hands it out again and
+// hides what the growth strategy itself leaves behind.
+int StartMemoryBenchmark() {
+    std::cout << "capacity/size, MB requested for the buffers, MB of heap in use (incl. element-owned), MB RSS,\n"
+              << "fragmentation = free bytes left in malloc's bins per byte in use; each figure measured in its own process\n";
+    std::cout << std::left << std::setw(12) << "type" << std::setw(14) << "containers" << std::right
+              << std::setw(14) << "cap/size" << std::setw(18) << "requested MB" << std::setw(18) << "heap MB"
+              << std::setw(18) << "RSS MB" << std::setw(15) << "fragmentation" << "\n";
+
+    const std::string long_text(40, 's'); // past the small string buffer, every element owns a heap block
+    compareContainerMemory<int>("int", sizeof(int), [](size_t i) { return static_cast<int>(i); });
+    compareContainerMemory<double>("double", sizeof(double), [](size_t i) { return static_cast<double>(i); });
+    compareContainerMemory<std::string>("string", sizeof(std::string) + 48, [&](size_t) { return long_text; });
+    compareContainerMemory<TestObject>("TestObject", sizeof(TestObject) + 16 * sizeof(int) + 32,
+                                       [](size_t) { return TestObject("obj", 16); });
+    compareContainerMemory<blck::rotcev<int>>("rotcev<int>", sizeof(blck::rotcev<int>) + 4 * sizeof(int) + 16, [](size_t) {
+        blck::rotcev<int> inner;
+        for (int i = 0; i < 4; ++i) inner.push_back(i);
+        return inner;
+    });
+
+    std::cout << "int by growth strategy:\n";
+    compareContainerMemory<int, blck::geometric_growth<3, 2>>("1.5x", sizeof(int), [](size_t i) { return static_cast<int>(i); });
+    compareContainerMemory<int, blck::power_of_two_growth>("pow2", sizeof(int), [](size_t i) { return static_cast<int>(i); });
+    compareContainerMemory<int, blck::page_aligned_growth<>>("page", sizeof(int), [](size_t i) { return static_cast<int>(i); });
+    compareContainerMemory<int, blck::capped_linear_growth<(size_t(64) << 10)>>("capped 64K", sizeof(int),
+                                                                                [](size_t i) { return static_cast<int>(i); });
+    return 0;
+}
+
+// Runs this program again with the given arguments, its output going to ours;
+// false when it could not be started or failed
+bool runSelfInChild(const std::vector<std::string>& arguments) {
+    std::cout.flush();
+    std::string program = "/proc/self/exe";
+    std::vector<char*> args = {&program[0]};
+    std::vector<std::string> copies = arguments;
+    for (auto& argument : copies) args.push_back(&argument[0]);
+    args.push_back(nullptr);
+    pid_t child = 0;
+    if (posix_spawn(&child, program.c_str(), nullptr, nullptr, args.data(), environ) != 0) return false;
+    int status = 0;
+    while (waitpid(child, &status, 0) < 0) {
+        if (errno != EINTR) return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// IPC and misses per element of every case, from -test --counters.
+// Elements are the operations a case reports (timeOperation) or the count in
+// its name; cases without one are per case. Only the calling thread is
+// counted, the parallel cases show the serial part.
+void printCounterAnalysis() {
+    if (!g_perf) return;
+    std::cout << "\n🔬 HARDWARE COUNTERS (per element):\n";
+    std::cout << std::string(50, '-') << "\n";
+    if (!g_perf->status().empty()) {
+        std::cout << "Unavailable: " << g_perf->status() << "\n";
+    }
+    if (!g_perf->available()) return;
+
+    using blck::bench::counter;
+    const counter per_element[] = {counter::l1d_misses, counter::llc_misses, counter::branch_misses, counter::page_faults};
+    const char* labels[] = {"L1d miss", "LLC miss", "br miss", "faults"};
+    bool has_ipc = g_perf->has(counter::cycles) && g_perf->has(counter::instructions);
+
+    std::cout << std::left << std::setw(44) << "test" << std::setw(8) << "side";
+    if (has_ipc) std::cout << std::right << std::setw(8) << "IPC";
+    for (size_t i = 0; i < 4; ++i) {
+        if (g_perf->has(per_element[i])) std::cout << std::right << std::setw(12) << labels[i];
+    }
+    std::cout << "\n";
+
+    blck::bench::counter_values total[2];
+    std::string section;
+    for (const BenchmarkRecord& r : g_stats.records) {
+        if (!r.rotcev_counters.any() && !r.std_counters.any()) continue;
+        if (r.section != section) {
+            section = r.section;
+            std::cout << section << "\n";
+        }
+        const blck::bench::counter_values* sides[] = {&r.rotcev_counters, &r.std_counters};
+        const long long elements[] = {r.rotcev_elements, r.std_elements};
+        for (int side = 0; side < 2; ++side) {
+            total[side] += *sides[side];
+            std::string name = r.name + (r.type.empty() ? "" : " [" + r.type + "]");
+            std::cout << "  " << std::left << std::setw(42) << (side == 0 ? name.substr(0, 41) : "")
+                      << std::setw(8) << (side == 0 ? "rotcev" : "std") << std::right << std::fixed;
+            if (has_ipc) std::cout << std::setw(8) << std::setprecision(2) << sides[side]->ipc();
+            for (counter c : per_element) {
+                if (!g_perf->has(c)) continue;
+                std::cout << std::setw(12) << std::setprecision(3)
+                          << static_cast<double>((*sides[side])[c]) / static_cast<double>(std::max(1LL, elements[side]));
+            }
+            std::cout << "\n";
+        }
+    }
+    if (has_ipc) {
+        std::cout << "Overall IPC: rotcev " << std::setprecision(2) << total[0].ipc()
+                  << ", std::vector " << total[1].ipc() << "\n";
+    }
+    for (counter c : per_element) {
+        if (!g_perf->has(c)) continue;
+        std::cout << "Total " << blck::bench::counter_name(c) << ": rotcev " << total[0][c]
+                  << ", std::vector " << total[1][c] << "\n";
+    }
+}
+
+// rotcev's own allocation counters (ROTCEV_STATS, on in the Profile build).
+// Element types that reallocate often relative to their allocations are the
+// ones whose containers should be reserve()d up front.
+void printAllocationStats() {
+    if (!blck::stats::enabled) return;
+    blck::stats::snapshot snapshot = blck::stats::collect();
+    std::cout << "\n📦 ROTCEV ALLOCATIONS (ROTCEV_STATS):\n";
+    std::cout << std::string(50, '-') << "\n";
+    std::cout << "Allocations: " << snapshot.total.allocations << ", frees: " << snapshot.total.frees
+              << ", reallocations: " << snapshot.total.reallocations << "\n"
+              << "Bytes relocated: " << snapshot.total.bytes_relocated << ", element moves: " << snapshot.total.element_moves << "\n"
+              << "Peak live bytes: " << snapshot.peak_live_bytes << ", slack at release: " << std::fixed << std::setprecision(1)
+              << 100.0 * snapshot.total.slack_ratio() << "%\n";
+    std::cout << std::left << std::setw(44) << "element type" << std::right << std::setw(10) << "allocs"
+              << std::setw(10) << "reallocs" << std::setw(14) << "relocated B" << std::setw(12) << "moves"
+              << std::setw(14) << "peak cap B" << std::setw(8) << "slack" << "\n";
+    size_t shown = 0;
+    for (const blck::stats::type_counters& type : snapshot.types) {
+        if (shown++ == 10) break;
+        std::cout << std::left << std::setw(44) << type.type.substr(0, 43) << std::right
+                  << std::setw(10) << type.values.allocations << std::setw(10) << type.values.reallocations
+                  << std::setw(14) << type.values.bytes_relocated << std::setw(12) << type.values.element_moves
+                  << std::setw(14) << type.values.peak_capacity_bytes
+                  << std::setw(7) << std::setprecision(1) << 100.0 * type.values.slack_ratio() << "%\n";
+    }
+}
+
 int StartBenchmark() {
     printHeader("ROTCEV vs STD::VECTOR PERFORMANCE BENCHMARK");
     
@@ -288,6 +693,7 @@ int StartBenchmark() {
     std::cout << "\nContainer Sizes:\n";
     std::cout << "  blck::rotcev<std::string>: " << sizeof(blck::rotcev<std::string>) << " bytes\n";
     std::cout << "  std::vector<std::string>:  " << sizeof(std::vector<std::string>) << " bytes\n";
+    std::cout << "  blck::small_rotcev<int, 16>: " << sizeof(blck::small_rotcev<int, 16>) << " bytes\n";
     
     // Test 1: Integer operations (trivial type)
     printSubHeader("INT OPERATIONS (Trivial Type)");
@@ -442,17 +848,17 @@ int StartBenchmark() {
                 blck::rotcev<int> rotcev_large_int;
                 std::vector<int> std_large_int;
                 
-                auto start_rotcev = std::chrono::high_resolution_clock::now();
+                auto start_rotcev = caseStart(CaseSide::Rotcev);
                 for (size_t i = 0; i < bulk_size; ++i) {
                     rotcev_large_int.push_back(large_ints[i]);
                 }
-                auto end_rotcev = std::chrono::high_resolution_clock::now();
+                auto end_rotcev = caseStop(CaseSide::Rotcev);
                 
-                auto start_std = std::chrono::high_resolution_clock::now();
+                auto start_std = caseStart(CaseSide::Std);
                 for (size_t i = 0; i < bulk_size; ++i) {
                     std_large_int.push_back(large_ints[i]);
                 }
-                auto end_std = std::chrono::high_resolution_clock::now();
+                auto end_std = caseStop(CaseSide::Std);
                 
                 long long rotcev_time = (end_rotcev - start_rotcev).count();
                 long long std_time = (end_std - start_std).count();
@@ -462,21 +868,21 @@ int StartBenchmark() {
                 printResult(ss.str(), rotcev_time, std_time, "large_int");
                 
                 // Test random access on large container
-                start_rotcev = std::chrono::high_resolution_clock::now();
+                start_rotcev = caseStart(CaseSide::Rotcev);
                 for (size_t i = 0; i < 100; ++i) {
                     size_t idx = (i * 17 + 3) % bulk_size; // pseudo-random access
                     auto val = rotcev_large_int[idx];
                     (void)val;
                 }
-                end_rotcev = std::chrono::high_resolution_clock::now();
+                end_rotcev = caseStop(CaseSide::Rotcev);
                 
-                start_std = std::chrono::high_resolution_clock::now();
+                start_std = caseStart(CaseSide::Std);
                 for (size_t i = 0; i < 100; ++i) {
                     size_t idx = (i * 17 + 3) % bulk_size; // same pattern
                     auto val = std_large_int[idx];
                     (void)val;
                 }
-                end_std = std::chrono::high_resolution_clock::now();
+                end_std = caseStop(CaseSide::Std);
                 
                 rotcev_time = (end_rotcev - start_rotcev).count();
                 std_time = (end_std - start_std).count();
@@ -491,17 +897,17 @@ int StartBenchmark() {
                 blck::rotcev<std::string> rotcev_large_str;
                 std::vector<std::string> std_large_str;
                 
-                auto start_rotcev = std::chrono::high_resolution_clock::now();
+                auto start_rotcev = caseStart(CaseSide::Rotcev);
                 for (size_t i = 0; i < bulk_size; ++i) {
                     rotcev_large_str.push_back(large_strings[i]);
                 }
-                auto end_rotcev = std::chrono::high_resolution_clock::now();
+                auto end_rotcev = caseStop(CaseSide::Rotcev);
                 
-                auto start_std = std::chrono::high_resolution_clock::now();
+                auto start_std = caseStart(CaseSide::Std);
                 for (size_t i = 0; i < bulk_size; ++i) {
                     std_large_str.push_back(large_strings[i]);
                 }
-                auto end_std = std::chrono::high_resolution_clock::now();
+                auto end_std = caseStop(CaseSide::Std);
                 
                 long long rotcev_time = (end_rotcev - start_rotcev).count();
                 long long std_time = (end_std - start_std).count();
@@ -511,19 +917,19 @@ int StartBenchmark() {
                 printResult(ss.str(), rotcev_time, std_time, "large_string");
                 
                 // Test sequential access on large string container
-                start_rotcev = std::chrono::high_resolution_clock::now();
+                start_rotcev = caseStart(CaseSide::Rotcev);
                 for (size_t i = 0; i < 50; ++i) {
                     auto val = rotcev_large_str[i];
                     (void)val;
                 }
-                end_rotcev = std::chrono::high_resolution_clock::now();
+                end_rotcev = caseStop(CaseSide::Rotcev);
                 
-                start_std = std::chrono::high_resolution_clock::now();
+                start_std = caseStart(CaseSide::Std);
                 for (size_t i = 0; i < 50; ++i) {
                     auto val = std_large_str[i];
                     (void)val;
                 }
-                end_std = std::chrono::high_resolution_clock::now();
+                end_std = caseStop(CaseSide::Std);
                 
                 rotcev_time = (end_rotcev - start_rotcev).count();
                 std_time = (end_std - start_std).count();
@@ -538,17 +944,17 @@ int StartBenchmark() {
                 blck::rotcev<double> rotcev_large_dbl;
                 std::vector<double> std_large_dbl;
                 
-                auto start_rotcev = std::chrono::high_resolution_clock::now();
+                auto start_rotcev = caseStart(CaseSide::Rotcev);
                 for (size_t i = 0; i < bulk_size; ++i) {
                     rotcev_large_dbl.push_back(large_doubles[i]);
                 }
-                auto end_rotcev = std::chrono::high_resolution_clock::now();
+                auto end_rotcev = caseStop(CaseSide::Rotcev);
                 
-                auto start_std = std::chrono::high_resolution_clock::now();
+                auto start_std = caseStart(CaseSide::Std);
                 for (size_t i = 0; i < bulk_size; ++i) {
                     std_large_dbl.push_back(large_doubles[i]);
                 }
-                auto end_std = std::chrono::high_resolution_clock::now();
+                auto end_std = caseStop(CaseSide::Std);
                 
                 long long rotcev_time = (end_rotcev - start_rotcev).count();
                 long long std_time = (end_std - start_std).count();
@@ -580,18 +986,18 @@ int StartBenchmark() {
                 }
                 
                 // Test performance at this size
-                auto start_rotcev = std::chrono::high_resolution_clock::now();
+                auto start_rotcev = caseStart(CaseSide::Rotcev);
                 for (int i = 0; i < 10; ++i) {
                     growth_test.push_back(checkpoint + i);
                     rotcev_size++;
                 }
-                auto end_rotcev = std::chrono::high_resolution_clock::now();
+                auto end_rotcev = caseStop(CaseSide::Rotcev);
                 
-                auto start_std = std::chrono::high_resolution_clock::now();
+                auto start_std = caseStart(CaseSide::Std);
                 for (int i = 0; i < 10; ++i) {
                     std_growth_test.push_back(checkpoint + i);
                 }
-                auto end_std = std::chrono::high_resolution_clock::now();
+                auto end_std = caseStop(CaseSide::Std);
                 
                 long long rotcev_time = (end_rotcev - start_rotcev).count();
                 long long std_time = (end_std - start_std).count();
@@ -603,6 +1009,961 @@ int StartBenchmark() {
         }
     }
     
+    // Test 6: Nested containers, system heap vs monotonic arena
+    printSubHeader("NESTED CONTAINERS (Heap vs Arena Allocator)");
+    {
+        const size_t outer_size = 1000;
+        const size_t inner_size = 1000;
+
+        auto start_std = caseStart(CaseSide::Std);
+        {
+            std::vector<std::vector<int>> std_nested;
+            for (size_t i = 0; i < outer_size; ++i) {
+                std::vector<int> inner;
+                for (size_t j = 0; j < inner_size; ++j) {
+                    inner.push_back(static_cast<int>(j));
+                }
+                std_nested.push_back(std::move(inner));
+            }
+        }
+        auto end_std = caseStop(CaseSide::Std);
+        long long std_time = (end_std - start_std).count();
+
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
+        {
+            blck::rotcev<blck::rotcev<int>> rotcev_nested;
+            for (size_t i = 0; i < outer_size; ++i) {
+                blck::rotcev<int> inner;
+                for (size_t j = 0; j < inner_size; ++j) {
+                    inner.push_back(static_cast<int>(j));
+                }
+                rotcev_nested.push_back(std::move(inner));
+            }
+        }
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
+
+        std::stringstream ss;
+        ss << outer_size << "x" << inner_size << " heap fill";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), std_time, "nested_int");
+
+        using ArenaInner = blck::rotcev<int, blck::arena_allocator<int>>;
+        using ArenaOuter = blck::rotcev<ArenaInner, blck::arena_allocator<ArenaInner>>;
+
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        {
+            blck::monotonic_arena arena(1 << 20);
+            ArenaOuter rotcev_nested{blck::arena_allocator<ArenaInner>(arena)};
+            for (size_t i = 0; i < outer_size; ++i) {
+                ArenaInner inner{blck::arena_allocator<int>(arena)};
+                for (size_t j = 0; j < inner_size; ++j) {
+                    inner.push_back(static_cast<int>(j));
+                }
+                rotcev_nested.push_back(std::move(inner));
+            }
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+
+        ss.str("");
+        ss << outer_size << "x" << inner_size << " arena fill";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), std_time, "nested_int");
+    }
+    
+    // Test 7: Loading a large batch with known size
+    printSubHeader("BULK LOAD (reserve / append_range)");
+    {
+        const size_t batch_size = 1000000;
+        std::vector<int> batch(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            batch[i] = static_cast<int>(i);
+        }
+
+        // Reserve up front, then push_back
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
+        {
+            blck::rotcev<int> rotcev_batch;
+            rotcev_batch.reserve(batch_size);
+            for (size_t i = 0; i < batch_size; ++i) {
+                rotcev_batch.push_back(batch[i]);
+            }
+        }
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
+
+        auto start_std = caseStart(CaseSide::Std);
+        {
+            std::vector<int> std_batch;
+            std_batch.reserve(batch_size);
+            for (size_t i = 0; i < batch_size; ++i) {
+                std_batch.push_back(batch[i]);
+            }
+        }
+        auto end_std = caseStop(CaseSide::Std);
+
+        std::stringstream ss;
+        ss << batch_size << " reserve+push_back";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "bulk_load");
+
+        // One block append
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        {
+            blck::rotcev<int> rotcev_batch;
+            rotcev_batch.append_range(batch);
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+
+        start_std = caseStart(CaseSide::Std);
+        {
+            std::vector<int> std_batch;
+            std_batch.insert(std_batch.end(), batch.begin(), batch.end());
+        }
+        end_std = caseStop(CaseSide::Std);
+
+        ss.str("");
+        ss << batch_size << " append_range";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "bulk_load");
+    }
+    
+    // Test 8: Many short-lived tiny containers
+    printSubHeader("SMALL CONTAINERS (small_rotcev<T, 16> vs std::vector)");
+    {
+        const size_t container_count = 10000;
+        std::vector<size_t> element_counts = {4, 8, 16, 32};
+
+        for (size_t element_count : element_counts) {
+            auto start_rotcev = caseStart(CaseSide::Rotcev);
+            for (size_t c = 0; c < container_count; ++c) {
+                blck::small_rotcev<int, 16> small;
+                for (size_t i = 0; i < element_count; ++i) {
+                    small.push_back(static_cast<int>(i));
+                }
+            }
+            auto end_rotcev = caseStop(CaseSide::Rotcev);
+
+            auto start_std = caseStart(CaseSide::Std);
+            for (size_t c = 0; c < container_count; ++c) {
+                std::vector<int> small;
+                for (size_t i = 0; i < element_count; ++i) {
+                    small.push_back(static_cast<int>(i));
+                }
+            }
+            auto end_std = caseStop(CaseSide::Std);
+
+            std::stringstream ss;
+            ss << container_count << "x" << element_count << " small int";
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "small_int");
+
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            for (size_t c = 0; c < container_count; ++c) {
+                blck::small_rotcev<std::string, 16> small;
+                for (size_t i = 0; i < element_count; ++i) {
+                    small.push_back("small");
+                }
+            }
+            end_rotcev = caseStop(CaseSide::Rotcev);
+
+            start_std = caseStart(CaseSide::Std);
+            for (size_t c = 0; c < container_count; ++c) {
+                std::vector<std::string> small;
+                for (size_t i = 0; i < element_count; ++i) {
+                    small.push_back("small");
+                }
+            }
+            end_std = caseStop(CaseSide::Std);
+
+            ss.str("");
+            ss << container_count << "x" << element_count << " small string";
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "small_string");
+        }
+    }
+    
+    // Test 9: Growth of large trivially copyable buffers
+    printSubHeader("LARGE BUFFER GROWTH (realloc / mremap)");
+    {
+        // Each step fills the buffer to capacity and then times a single doubling
+        std::vector<size_t> growth_steps = {1u << 20, 1u << 21, 1u << 22, 1u << 23};
+
+        blck::rotcev<int> realloc_container;
+        blck::rotcev<int, blck::vm_allocator<int, (size_t(1) << 20), true>> mremap_container;
+        std::vector<int> std_container;
+
+        for (size_t step : growth_steps) {
+            realloc_container.resize(step, 1);
+            mremap_container.resize(step, 1);
+            std_container.resize(step, 1);
+
+            auto start_rotcev = caseStart(CaseSide::Rotcev);
+            realloc_container.reserve(step * 2);
+            auto end_rotcev = caseStop(CaseSide::Rotcev);
+
+            auto start_std = caseStart(CaseSide::Std);
+            std_container.reserve(step * 2);
+            auto end_std = caseStop(CaseSide::Std);
+            long long std_time = (end_std - start_std).count();
+
+            std::stringstream ss;
+            ss << "grow " << step << " realloc";
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), std_time, "large_growth");
+
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            mremap_container.reserve(step * 2);
+            end_rotcev = caseStop(CaseSide::Rotcev);
+
+            ss.str("");
+            ss << "grow " << step << " mremap";
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), std_time, "large_growth");
+        }
+    }
+    
+    // Test 10: Growth policies, time vs unused capacity
+    printSubHeader("GROWTH POLICIES (push_back time and slack)");
+    {
+        const size_t fill_size = 100000;
+
+        auto start_std = caseStart(CaseSide::Std);
+        std::vector<int> std_fill;
+        for (size_t i = 0; i < fill_size; ++i) {
+            std_fill.push_back(static_cast<int>(i));
+        }
+        auto end_std = caseStop(CaseSide::Std);
+        long long std_time = (end_std - start_std).count();
+
+        auto runPolicy = [&](auto policy_tag, const std::string& policy_name) {
+            using Policy = decltype(policy_tag);
+            blck::rotcev<int, blck::malloc_allocator<int>, Policy> rotcev_fill;
+
+            auto start_rotcev = caseStart(CaseSide::Rotcev);
+            for (size_t i = 0; i < fill_size; ++i) {
+                rotcev_fill.push_back(static_cast<int>(i));
+            }
+            auto end_rotcev = caseStop(CaseSide::Rotcev);
+
+            printResult(policy_name + " fill", (end_rotcev - start_rotcev).count(), std_time, "growth_policy");
+            std::cout << "    capacity " << rotcev_fill.capacity() << " (std::vector " << std_fill.capacity() << "), slack "
+                      << std::fixed << std::setprecision(1)
+                      << (100.0 * (rotcev_fill.capacity() - rotcev_fill.size()) / rotcev_fill.capacity()) << "%\n";
+        };
+
+        runPolicy(blck::default_growth{}, "default");
+        runPolicy(blck::geometric_growth<3, 2>{}, "geometric 1.5x");
+        runPolicy(blck::power_of_two_growth{}, "power of two");
+        runPolicy(blck::page_aligned_growth<>{}, "page aligned");
+        runPolicy(blck::capped_linear_growth<(size_t(64) << 10)>{}, "capped linear 64K");
+    }
+    
+    // Test 11: Standard algorithms straight on rotcev iterators
+    printSubHeader("STD ALGORITHMS (sort / lower_bound / accumulate)");
+    {
+        const size_t algo_size = 200000;
+        blck::rotcev<int> rotcev_algo;
+        std::vector<int> std_algo;
+        for (size_t i = 0; i < algo_size; ++i) {
+            int value = static_cast<int>((i * 2654435761u) % algo_size);
+            rotcev_algo.push_back(value);
+            std_algo.push_back(value);
+        }
+
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
+        std::sort(rotcev_algo.begin(), rotcev_algo.end());
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
+
+        auto start_std = caseStart(CaseSide::Std);
+        std::sort(std_algo.begin(), std_algo.end());
+        auto end_std = caseStop(CaseSide::Std);
+
+        std::stringstream ss;
+        ss << algo_size << " std::sort";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "algorithms");
+
+        volatile size_t found = 0;
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        for (size_t i = 0; i < 1000; ++i) {
+            found = found + (std::lower_bound(rotcev_algo.cbegin(), rotcev_algo.cend(), static_cast<int>(i * 97)) - rotcev_algo.cbegin());
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+
+        start_std = caseStart(CaseSide::Std);
+        for (size_t i = 0; i < 1000; ++i) {
+            found = found + (std::lower_bound(std_algo.cbegin(), std_algo.cend(), static_cast<int>(i * 97)) - std_algo.cbegin());
+        }
+        end_std = caseStop(CaseSide::Std);
+
+        printResult("1000 lower_bound", (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "algorithms");
+
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        volatile long long rotcev_sum = std::accumulate(rotcev_algo.cbegin(), rotcev_algo.cend(), 0LL);
+        end_rotcev = caseStop(CaseSide::Rotcev);
+
+        start_std = caseStart(CaseSide::Std);
+        volatile long long std_sum = std::accumulate(std_algo.cbegin(), std_algo.cend(), 0LL);
+        end_std = caseStop(CaseSide::Std);
+        (void)rotcev_sum;
+        (void)std_sum;
+
+        ss.str("");
+        ss << algo_size << " accumulate";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "algorithms");
+    }
+    
+    // Test 12: Vectorized kernels against the plain scalar loops
+    printSubHeader("SIMD KERNELS (simd:: on rotcev vs scalar loop on std::vector)");
+    {
+        std::cout << "Active instruction set: " << blck::simd::isa_name(blck::simd::active_isa()) << "\n";
+        const size_t simd_size = 1000000;
+        const int simd_runs = 20;
+
+        auto runKernels = [&](auto zero, const std::string& type_name) {
+            using T = decltype(zero);
+            blck::rotcev<T> rotcev_data;
+            blck::rotcev<T> rotcev_out;
+            std::vector<T> std_data(simd_size);
+            std::vector<T> std_out(simd_size);
+            rotcev_data.resize(simd_size);
+
+            // fill, reading one element back so the repeated fills are not folded away
+            volatile T sink = T{};
+            auto start_rotcev = caseStart(CaseSide::Rotcev);
+            for (int run = 0; run < simd_runs; ++run) {
+                blck::simd::fill(rotcev_data, static_cast<T>(run));
+                sink = sink + rotcev_data[static_cast<size_t>(run)];
+            }
+            auto end_rotcev = caseStop(CaseSide::Rotcev);
+            auto start_std = caseStart(CaseSide::Std);
+            for (int run = 0; run < simd_runs; ++run) {
+                for (size_t i = 0; i < simd_size; ++i) {
+                    std_data[i] = static_cast<T>(run);
+                }
+                sink = sink + std_data[static_cast<size_t>(run)];
+            }
+            auto end_std = caseStop(CaseSide::Std);
+            printResult("fill", (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), type_name);
+
+            // iota, keeps the values small enough for every type
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            for (int run = 0; run < simd_runs; ++run) {
+                blck::simd::iota(rotcev_data.data(), simd_size, static_cast<T>(run));
+            }
+            end_rotcev = caseStop(CaseSide::Rotcev);
+            start_std = caseStart(CaseSide::Std);
+            for (int run = 0; run < simd_runs; ++run) {
+                for (size_t i = 0; i < simd_size; ++i) {
+                    std_data[i] = static_cast<T>(run) + static_cast<T>(i);
+                }
+            }
+            end_std = caseStop(CaseSide::Std);
+            printResult("iota", (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), type_name);
+
+            // sum
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            for (int run = 0; run < simd_runs; ++run) {
+                sink = sink + blck::simd::sum(rotcev_data);
+            }
+            end_rotcev = caseStop(CaseSide::Rotcev);
+            start_std = caseStart(CaseSide::Std);
+            for (int run = 0; run < simd_runs; ++run) {
+                T total = T{};
+                for (size_t i = 0; i < simd_size; ++i) {
+                    total += std_data[i];
+                }
+                sink = sink + total;
+            }
+            end_std = caseStop(CaseSide::Std);
+            printResult("sum", (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), type_name);
+
+            // min + max
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            for (int run = 0; run < simd_runs; ++run) {
+                sink = sink + blck::simd::min(rotcev_data) + blck::simd::max(rotcev_data);
+            }
+            end_rotcev = caseStop(CaseSide::Rotcev);
+            start_std = caseStart(CaseSide::Std);
+            for (int run = 0; run < simd_runs; ++run) {
+                T lowest = std_data[0];
+                T highest = std_data[0];
+                for (size_t i = 0; i < simd_size; ++i) {
+                    lowest = std_data[i] < lowest ? std_data[i] : lowest;
+                    highest = std_data[i] > highest ? std_data[i] : highest;
+                }
+                sink = sink + lowest + highest;
+            }
+            end_std = caseStop(CaseSide::Std);
+            printResult("min/max", (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), type_name);
+
+            // find the last element, count a value that appears once
+            volatile size_t index_sink = 0;
+            const T needle = rotcev_data[simd_size - 1];
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            for (int run = 0; run < simd_runs; ++run) {
+                index_sink = index_sink + blck::simd::find(rotcev_data, needle) + blck::simd::count(rotcev_data, needle);
+            }
+            end_rotcev = caseStop(CaseSide::Rotcev);
+            start_std = caseStart(CaseSide::Std);
+            for (int run = 0; run < simd_runs; ++run) {
+                size_t found = simd_size;
+                for (size_t i = 0; i < simd_size; ++i) {
+                    if (std_data[i] == needle) {
+                        found = i;
+                        break;
+                    }
+                }
+                size_t matches = 0;
+                for (size_t i = 0; i < simd_size; ++i) {
+                    matches += (std_data[i] == needle) ? 1 : 0;
+                }
+                index_sink = index_sink + found + matches;
+            }
+            end_std = caseStop(CaseSide::Std);
+            printResult("find/count", (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), type_name);
+
+            // transform (x * 3 + 1) and dot
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            for (int run = 0; run < simd_runs; ++run) {
+                blck::simd::transform(rotcev_data, rotcev_out, static_cast<T>(3), static_cast<T>(1));
+                sink = sink + blck::simd::dot(rotcev_data, rotcev_out);
+            }
+            end_rotcev = caseStop(CaseSide::Rotcev);
+            start_std = caseStart(CaseSide::Std);
+            for (int run = 0; run < simd_runs; ++run) {
+                for (size_t i = 0; i < simd_size; ++i) {
+                    std_out[i] = std_data[i] * static_cast<T>(3) + static_cast<T>(1);
+                }
+                T total = T{};
+                for (size_t i = 0; i < simd_size; ++i) {
+                    total += std_data[i] * std_out[i];
+                }
+                sink = sink + total;
+            }
+            end_std = caseStop(CaseSide::Std);
+            printResult("transform+dot", (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), type_name);
+            (void)sink;
+            (void)index_sink;
+        };
+
+        runKernels(int{}, "simd_int");
+        runKernels(float{}, "simd_float");
+        runKernels(double{}, "simd_double");
+    }
+    
+    // Test 13: Parallel algorithms on the global thread pool against serial loops
+    printSubHeader("PARALLEL ALGORITHMS (thread pool vs serial std::vector)");
+    {
+        blck::thread_pool& pool = blck::thread_pool::global();
+        std::cout << "Worker threads: " << pool.size() << "\n";
+        const size_t parallel_size = 4000000;
+
+        blck::rotcev<double> rotcev_values;
+        rotcev_values.resize(parallel_size);
+        std::vector<double> std_values(parallel_size);
+        for (size_t i = 0; i < parallel_size; ++i) {
+            double value = static_cast<double>((i * 2654435761u) % parallel_size) * 0.5;
+            rotcev_values[i] = value;
+            std_values[i] = value;
+        }
+
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
+        volatile double rotcev_total = blck::parallel_reduce(rotcev_values, 0.0, std::plus<>());
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
+        auto start_std = caseStart(CaseSide::Std);
+        volatile double std_total = std::accumulate(std_values.begin(), std_values.end(), 0.0);
+        auto end_std = caseStop(CaseSide::Std);
+        (void)rotcev_total;
+        (void)std_total;
+        std::stringstream ss;
+        ss << parallel_size << " reduce";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "parallel");
+
+        blck::rotcev<double> rotcev_out;
+        rotcev_out.resize(parallel_size);
+        std::vector<double> std_out(parallel_size);
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        blck::parallel_transform(rotcev_values, rotcev_out, [](double value) { return std::sqrt(value) * 1.5 + 1.0; });
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        std::transform(std_values.begin(), std_values.end(), std_out.begin(), [](double value) { return std::sqrt(value) * 1.5 + 1.0; });
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << parallel_size << " transform";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "parallel");
+
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        blck::parallel_sort(rotcev_values);
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        std::sort(std_values.begin(), std_values.end());
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << parallel_size << " sort";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "parallel");
+    }
+    
+    // Test 14: Many producers appending at once
+    printSubHeader("CONCURRENT APPEND (rotcev_concurrent vs std::vector + mutex)");
+    {
+        const size_t appends_per_thread = 500000;
+        for (size_t producer_count : {1, 2, 4}) {
+            blck::rotcev_concurrent<int> rotcev_shared;
+            auto start_rotcev = caseStart(CaseSide::Rotcev);
+            {
+                std::vector<std::thread> producers;
+                for (size_t t = 0; t < producer_count; ++t) {
+                    producers.emplace_back([&rotcev_shared, t, appends_per_thread]() {
+                        for (size_t i = 0; i < appends_per_thread; ++i) {
+                            rotcev_shared.push_back(static_cast<int>(t * appends_per_thread + i));
+                        }
+                    });
+                }
+                for (std::thread& producer : producers) {
+                    producer.join();
+                }
+            }
+            auto end_rotcev = caseStop(CaseSide::Rotcev);
+
+            std::vector<int> std_shared;
+            std::mutex std_mutex;
+            auto start_std = caseStart(CaseSide::Std);
+            {
+                std::vector<std::thread> producers;
+                for (size_t t = 0; t < producer_count; ++t) {
+                    producers.emplace_back([&std_shared, &std_mutex, t, appends_per_thread]() {
+                        for (size_t i = 0; i < appends_per_thread; ++i) {
+                            std::lock_guard<std::mutex> lock(std_mutex);
+                            std_shared.push_back(static_cast<int>(t * appends_per_thread + i));
+                        }
+                    });
+                }
+                for (std::thread& producer : producers) {
+                    producer.join();
+                }
+            }
+            auto end_std = caseStop(CaseSide::Std);
+
+            std::stringstream ss;
+            ss << producer_count << " producers x " << appends_per_thread;
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "concurrent");
+        }
+    }
+    
+    // Test 15: Worst-case push_back latency, segmented growth vs whole-buffer relocation
+    printSubHeader("PUSH_BACK TAIL LATENCY (segmented_rotcev / incremental_rotcev vs std::vector)");
+    {
+        const size_t latency_size = 4000000;
+        blck::segmented_rotcev<std::string> segmented;
+        std::vector<std::string> std_objects;
+        long long segmented_worst = 0;
+        long long std_worst = 0;
+
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
+        for (size_t i = 0; i < latency_size; ++i) {
+            auto before = std::chrono::high_resolution_clock::now();
+            segmented.push_back(std::to_string(i));
+            long long elapsed = (std::chrono::high_resolution_clock::now() - before).count();
+            segmented_worst = std::max(segmented_worst, elapsed);
+        }
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
+
+        auto start_std = caseStart(CaseSide::Std);
+        for (size_t i = 0; i < latency_size; ++i) {
+            auto before = std::chrono::high_resolution_clock::now();
+            std_objects.push_back(std::to_string(i));
+            long long elapsed = (std::chrono::high_resolution_clock::now() - before).count();
+            std_worst = std::max(std_worst, elapsed);
+        }
+        auto end_std = caseStop(CaseSide::Std);
+
+        std::stringstream ss;
+        ss << latency_size << " total";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "segmented");
+        printResult("worst single push_back", segmented_worst, std_worst, "segmented");
+
+        // Same workload with the relocation spread over later push_backs
+        blck::incremental_rotcev<std::string> incremental;
+        long long incremental_worst = 0;
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        for (size_t i = 0; i < latency_size; ++i) {
+            auto before = std::chrono::high_resolution_clock::now();
+            incremental.push_back(std::to_string(i));
+            long long elapsed = (std::chrono::high_resolution_clock::now() - before).count();
+            incremental_worst = std::max(incremental_worst, elapsed);
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+
+        ss.str("");
+        ss << latency_size << " incremental total";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "incremental");
+        printResult("worst incremental push_back", incremental_worst, std_worst, "incremental");
+    }
+    
+    // Test 16: Reloading a persisted buffer, mmap view vs read() into a vector
+    printSubHeader("PERSISTED RELOAD (mapped_rotcev vs std::ifstream into std::vector)");
+    {
+        const size_t persisted_size = 10000000;
+        const std::filesystem::path temp_dir = std::filesystem::temp_directory_path();
+        const std::string mapped_path = (temp_dir / "rotcev_bench_mapped.bin").string();
+        const std::string stream_path = (temp_dir / "rotcev_bench_stream.bin").string();
+
+        std::vector<double> source(persisted_size);
+        for (size_t i = 0; i < persisted_size; ++i) {
+            source[i] = static_cast<double>(i) * 0.25;
+        }
+
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
+        {
+            blck::mapped_rotcev<double> mapped(mapped_path, blck::map_mode::truncate);
+            // No msync, the ofstream side does not fsync either
+            mapped.append(source.data(), source.size());
+        }
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
+        auto start_std = caseStart(CaseSide::Std);
+        {
+            std::ofstream out(stream_path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(source.data()), static_cast<std::streamsize>(source.size() * sizeof(double)));
+            out.flush();
+        }
+        auto end_std = caseStop(CaseSide::Std);
+        std::stringstream ss;
+        ss << persisted_size << " persist";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "mapped");
+
+        // Open only: what a restarting service pays before its first access
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        size_t mapped_count = 0;
+        {
+            blck::mapped_rotcev<double> mapped(mapped_path, blck::map_mode::read_only);
+            mapped_count = mapped.size();
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        size_t stream_count = 0;
+        {
+            std::ifstream in(stream_path, std::ios::binary);
+            std::vector<double> loaded(persisted_size);
+            in.read(reinterpret_cast<char*>(loaded.data()), static_cast<std::streamsize>(loaded.size() * sizeof(double)));
+            stream_count = loaded.size();
+        }
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << persisted_size << " reopen";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "mapped");
+
+        // Open and touch every element
+        volatile double mapped_sum = 0.0;
+        volatile double stream_sum = 0.0;
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        {
+            blck::mapped_rotcev<double> mapped(mapped_path, blck::map_mode::read_only);
+            mapped.advise(blck::access_hint::sequential);
+            mapped_sum = std::accumulate(mapped.cbegin(), mapped.cend(), 0.0);
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        {
+            std::ifstream in(stream_path, std::ios::binary);
+            std::vector<double> loaded(persisted_size);
+            in.read(reinterpret_cast<char*>(loaded.data()), static_cast<std::streamsize>(loaded.size() * sizeof(double)));
+            stream_sum = std::accumulate(loaded.cbegin(), loaded.cend(), 0.0);
+        }
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << persisted_size << " reopen + scan";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "mapped");
+        (void)mapped_count;
+        (void)stream_count;
+        (void)mapped_sum;
+        (void)stream_sum;
+
+        std::filesystem::remove(mapped_path);
+        std::filesystem::remove(stream_path);
+    }
+
+    // Test 17: Serializing nested containers, bulk format vs element-wise iostream
+    printSubHeader("BINARY SERIALIZATION (rotcev_io vs element-wise std::stringstream)");
+    {
+        // Same shape as Func::FillArray builds
+        const size_t outer_size = 1000;
+        const size_t inner_size = 10000;
+        blck::rotcev<blck::rotcev<int>> rotcev_nested;
+        std::vector<std::vector<int>> std_nested;
+        for (size_t i = 0; i < outer_size; ++i) {
+            blck::rotcev<int> rotcev_inner;
+            std::vector<int> std_inner;
+            rotcev_inner.reserve(inner_size);
+            std_inner.reserve(inner_size);
+            for (size_t j = 0; j < inner_size; ++j) {
+                rotcev_inner.push_back(static_cast<int>(j));
+                std_inner.push_back(static_cast<int>(j));
+            }
+            rotcev_nested.push_back(std::move(rotcev_inner));
+            std_nested.push_back(std::move(std_inner));
+        }
+
+        std::stringstream rotcev_stream(std::ios::in | std::ios::out | std::ios::binary);
+        std::stringstream std_stream(std::ios::in | std::ios::out | std::ios::binary);
+
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
+        blck::write_binary(rotcev_stream, rotcev_nested);
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
+        auto start_std = caseStart(CaseSide::Std);
+        {
+            uint64_t outer_count = std_nested.size();
+            std_stream.write(reinterpret_cast<const char*>(&outer_count), sizeof(outer_count));
+            for (const auto& inner : std_nested) {
+                uint64_t inner_count = inner.size();
+                std_stream.write(reinterpret_cast<const char*>(&inner_count), sizeof(inner_count));
+                for (int value : inner) {
+                    std_stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+                }
+            }
+        }
+        auto end_std = caseStop(CaseSide::Std);
+        std::stringstream ss;
+        ss << outer_size << "x" << inner_size << " write";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "io");
+
+        blck::rotcev<blck::rotcev<int>> rotcev_loaded;
+        std::vector<std::vector<int>> std_loaded;
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        blck::read_binary(rotcev_stream, rotcev_loaded);
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        {
+            uint64_t outer_count = 0;
+            std_stream.read(reinterpret_cast<char*>(&outer_count), sizeof(outer_count));
+            std_loaded.reserve(outer_count);
+            for (uint64_t i = 0; i < outer_count; ++i) {
+                uint64_t inner_count = 0;
+                std_stream.read(reinterpret_cast<char*>(&inner_count), sizeof(inner_count));
+                std::vector<int>& inner = std_loaded.emplace_back();
+                inner.reserve(inner_count);
+                for (uint64_t j = 0; j < inner_count; ++j) {
+                    int value = 0;
+                    std_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+                    inner.push_back(value);
+                }
+            }
+        }
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << outer_size << "x" << inner_size << " read";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "io");
+
+        // Chunked reading keeps one chunk of inner containers alive at a time
+        rotcev_stream.clear();
+        rotcev_stream.seekg(0);
+        volatile long long chunk_sum = 0;
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        {
+            blck::binary_chunk_reader<blck::rotcev<int>> reader(rotcev_stream, 64);
+            blck::rotcev<blck::rotcev<int>> chunk;
+            while (reader.next(chunk)) {
+                for (const auto& inner : chunk) {
+                    chunk_sum = chunk_sum + inner[inner.size() - 1];
+                }
+            }
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        (void)chunk_sum;
+        std::cout << "Chunked read of " << outer_size << " inner containers (64 per chunk): "
+                  << (end_rotcev - start_rotcev).count() << " ns\n";
+    }
+
+    // Test 18: Scanning one or two fields of a record, structure-of-arrays vs array-of-structs
+    printSubHeader("FIELD SCANS (rotcev_soa vs std::vector of structs)");
+    {
+        std::vector<size_t> soa_sizes = {100000, 1000000, 10000000};
+        for (size_t count : soa_sizes) {
+            blck::rotcev_soa<double, double, double, double, int, int> soa;
+            std::vector<ParticleRecord> aos;
+
+            auto start_rotcev = caseStart(CaseSide::Rotcev);
+            for (size_t i = 0; i < count; ++i) {
+                double v = static_cast<double>(i % 1000);
+                soa.push_back(v, v + 1.0, v + 2.0, 1.0 + v * 0.001, static_cast<int>(i), static_cast<int>(i & 7));
+            }
+            auto end_rotcev = caseStop(CaseSide::Rotcev);
+            auto start_std = caseStart(CaseSide::Std);
+            for (size_t i = 0; i < count; ++i) {
+                double v = static_cast<double>(i % 1000);
+                aos.push_back({v, v + 1.0, v + 2.0, 1.0 + v * 0.001, static_cast<int>(i), static_cast<int>(i & 7)});
+            }
+            auto end_std = caseStop(CaseSide::Std);
+            std::stringstream ss;
+            ss << count << " push_back";
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "soa");
+
+            // One field, same scalar loop on both sides: only the layout differs
+            volatile double soa_sum = 0.0;
+            volatile double aos_sum = 0.0;
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            {
+                double local = 0.0;
+                for (double mass : soa.column<3>()) {
+                    local += mass;
+                }
+                soa_sum = local;
+            }
+            end_rotcev = caseStop(CaseSide::Rotcev);
+            start_std = caseStart(CaseSide::Std);
+            {
+                double local = 0.0;
+                for (const ParticleRecord& record : aos) {
+                    local += record.mass;
+                }
+                aos_sum = local;
+            }
+            end_std = caseStop(CaseSide::Std);
+            ss.str("");
+            ss << count << " scan 1 field";
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "soa");
+
+            // Columns are plain arrays, so they go straight into the SIMD kernels
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            soa_sum = blck::simd::dot(soa.data<0>(), soa.data<3>(), soa.size());
+            end_rotcev = caseStop(CaseSide::Rotcev);
+            start_std = caseStart(CaseSide::Std);
+            {
+                double local = 0.0;
+                for (const ParticleRecord& record : aos) {
+                    local += record.x * record.mass;
+                }
+                aos_sum = local;
+            }
+            end_std = caseStop(CaseSide::Std);
+            ss.str("");
+            ss << count << " dot 2 fields";
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "soa");
+
+            volatile long long soa_ids = 0;
+            volatile long long aos_ids = 0;
+            start_rotcev = caseStart(CaseSide::Rotcev);
+            soa_ids = blck::simd::count(soa.data<5>(), soa.size(), 3);
+            end_rotcev = caseStop(CaseSide::Rotcev);
+            start_std = caseStart(CaseSide::Std);
+            aos_ids = std::count_if(aos.begin(), aos.end(), [](const ParticleRecord& record) { return record.flags == 3; });
+            end_std = caseStop(CaseSide::Std);
+            ss.str("");
+            ss << count << " count flag";
+            printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "soa");
+            (void)soa_sum;
+            (void)aos_sum;
+            (void)soa_ids;
+            (void)aos_ids;
+        }
+    }
+
+    // Test 19: Editing in place instead of rebuilding the container
+    printSubHeader("IN-PLACE EDITS (insert / erase / erase_if / unordered_erase)");
+    {
+        const size_t filter_size = 10000000;
+        blck::rotcev<int> rotcev_ints;
+        std::vector<int> std_ints;
+        for (size_t i = 0; i < filter_size; ++i) {
+            rotcev_ints.push_back(static_cast<int>(i));
+            std_ints.push_back(static_cast<int>(i));
+        }
+        auto is_dropped = [](int value) { return (value % 3) == 0 || (value % 7) == 0; };
+
+        auto start_rotcev = caseStart(CaseSide::Rotcev);
+        size_t rotcev_removed = blck::erase_if(rotcev_ints, is_dropped);
+        auto end_rotcev = caseStop(CaseSide::Rotcev);
+        auto start_std = caseStart(CaseSide::Std);
+        size_t std_before = std_ints.size();
+        std_ints.erase(std::remove_if(std_ints.begin(), std_ints.end(), is_dropped), std_ints.end());
+        size_t std_removed = std_before - std_ints.size();
+        auto end_std = caseStop(CaseSide::Std);
+        std::stringstream ss;
+        ss << filter_size << " erase_if int";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "int");
+        (void)rotcev_removed;
+        (void)std_removed;
+
+        // Non-trivial but relocatable elements take the memmove path too
+        const size_t owner_size = 1000000;
+        blck::rotcev<std::unique_ptr<int>> rotcev_owners;
+        std::vector<std::unique_ptr<int>> std_owners;
+        for (size_t i = 0; i < owner_size; ++i) {
+            rotcev_owners.push_back(std::make_unique<int>(static_cast<int>(i)));
+            std_owners.push_back(std::make_unique<int>(static_cast<int>(i)));
+        }
+        auto owner_dropped = [](const std::unique_ptr<int>& owner) { return (*owner & 1) == 0; };
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        blck::erase_if(rotcev_owners, owner_dropped);
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        std_owners.erase(std::remove_if(std_owners.begin(), std_owners.end(), owner_dropped), std_owners.end());
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << owner_size << " erase_if unique_ptr";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "unique_ptr");
+
+        // Inserting into the middle shifts the tail
+        const size_t insert_base = 100000;
+        const size_t insert_count = 10000;
+        blck::rotcev<int> rotcev_middle;
+        std::vector<int> std_middle;
+        for (size_t i = 0; i < insert_base; ++i) {
+            rotcev_middle.push_back(static_cast<int>(i));
+            std_middle.push_back(static_cast<int>(i));
+        }
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        for (size_t i = 0; i < insert_count; ++i) {
+            rotcev_middle.insert(rotcev_middle.cbegin() + rotcev_middle.size() / 2, static_cast<int>(i));
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        for (size_t i = 0; i < insert_count; ++i) {
+            std_middle.insert(std_middle.cbegin() + std_middle.size() / 2, static_cast<int>(i));
+        }
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << insert_count << " insert middle";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "int");
+
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        for (size_t i = 0; i < insert_count; ++i) {
+            rotcev_middle.erase(rotcev_middle.cbegin() + rotcev_middle.size() / 2);
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        for (size_t i = 0; i < insert_count; ++i) {
+            std_middle.erase(std_middle.cbegin() + std_middle.size() / 2);
+        }
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << insert_count << " erase middle";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "int");
+
+        // Order does not matter: swap-and-pop against the shifting erase
+        start_rotcev = caseStart(CaseSide::Rotcev);
+        for (size_t i = 0; i < insert_count; ++i) {
+            rotcev_middle.unordered_erase(rotcev_middle.cbegin() + rotcev_middle.size() / 2);
+        }
+        end_rotcev = caseStop(CaseSide::Rotcev);
+        start_std = caseStart(CaseSide::Std);
+        for (size_t i = 0; i < insert_count; ++i) {
+            std_middle.erase(std_middle.cbegin() + std_middle.size() / 2);
+        }
+        end_std = caseStop(CaseSide::Std);
+        ss.str("");
+        ss << insert_count << " unordered_erase";
+        printResult(ss.str(), (end_rotcev - start_rotcev).count(), (end_std - start_std).count(), "int");
+    }
+    
+    // Test 20: Memory cost of the growth strategies for varying final sizes
+    printSubHeader("MEMORY EFFICIENCY (rotcev / std::vector)");
+    // In a fresh process for a clean heap
+    if (!runSelfInChild({"-memory"})) {
+        StartMemoryBenchmark();
+    }
+
+    // Test 21: Throughput when every core builds its own containers at once
+    printSubHeader("MULTI-THREADED SCALING (rotcev / std::vector)");
+    if (!runSelfInChild({"-scaling"})) {
+        StartScalingBenchmark(ScalingOptions());
+    }
+    std::cout << "\nAll threads on a single malloc arena:\n";
+    // The arena limit only holds for threads that have not allocated yet
+    if (!runSelfInChild({"-scaling", "--arena-max", "1"})) {
+        std::cout << "could not start a separate process for it\n";
+    }
+
     printHeader("BENCHMARK COMPLETE");
     
     // Recalculate spike detection with dynamic threshold based on all collected data
@@ -972,6 +2333,9 @@ int StartBenchmark() {
         std::cout << "• ✅ No significant spikes detected - consistent performance!\n";
     }
     
+    printCounterAnalysis();
+    printAllocationStats();
+
     // Final verdict
     std::cout << "\n🏆 FINAL VERDICT:\n";
     std::cout << std::string(50, '=') << "\n";
@@ -1019,6 +2383,90 @@ int StartBenchmark() {
     std::cout << "  - Positive difference: Rotcev is slower\n";
     std::cout << "  - Negative difference: Rotcev is faster\n";
     std::cout << "  - Lower nanoseconds = better performance\n\n";
-    
+
+    return 0;
+}
+
+// Runs one silent pass of the suite in a fresh process (this executable with
+// -test --json) and reads its records back. Heap layout, page mappings and
+// ASLR differ between processes and move some timings by 2x, so passes run in
+// one process would understate the noise a baseline comparison has to expect.
+bool runBenchmarkPassInChild(const std::string& json_path, std::vector<BenchmarkRecord>& records) {
+    char program[] = "/proc/self/exe";
+    char test[] = "-test";
+    char json[] = "--json";
+    std::string path = json_path;
+    char* args[] = {program, test, json, path.data(), nullptr};
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    pid_t child = 0;
+    int error = posix_spawn(&child, program, &actions, nullptr, args, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (error != 0) return false;
+
+    int status = 0;
+    while (waitpid(child, &status, 0) < 0) {
+        if (errno != EINTR) return false;
+    }
+    bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0 && readJsonReport(json_path, records);
+    std::remove(json_path.c_str());
+    return ok;
+}
+
+// -test entry point: runs the suite output.repeat times (the first pass here
+// and printed, the others in child processes), then writes the per-test
+// medians and compares them with a baseline.
+// Returns 2 when a test regressed against the baseline.
+int RunBenchmarks(const BenchmarkOutputOptions& output) {
+    std::vector<std::vector<BenchmarkRecord>> runs;
+    if (output.counters) {
+        g_perf = std::make_unique<blck::bench::perf_counters>();
+        if (!g_perf->available()) {
+            std::cerr << "perf counters disabled: " << g_perf->status() << "\n";
+            g_perf.reset();
+        }
+    }
+    StartBenchmark();
+    runs.push_back(g_stats.records);
+    for (int pass = 1; pass < output.repeat; pass++) {
+        std::cerr << "Repeat " << pass + 1 << "/" << output.repeat << "\n";
+        std::filesystem::path pass_path = std::filesystem::temp_directory_path() /
+            ("rotcev_pass_" + std::to_string(getpid()) + "_" + std::to_string(pass) + ".json");
+        std::vector<BenchmarkRecord> records;
+        if (!runBenchmarkPassInChild(pass_path.string(), records)) {
+            std::cerr << "Benchmark pass " << pass + 1 << " failed\n";
+            return 1;
+        }
+        runs.push_back(std::move(records));
+    }
+
+    std::vector<BenchmarkRecord> records = aggregateRuns(runs);
+    BenchmarkEnvironment env = collectEnvironment();
+    if (!output.json_path.empty()) {
+        if (!writeJsonReport(output.json_path, env, records)) {
+            std::cerr << "Could not write " << output.json_path << "\n";
+            return 1;
+        }
+        std::cout << "Results written to " << output.json_path << "\n";
+    }
+    if (!output.csv_path.empty()) {
+        if (!writeCsvReport(output.csv_path, env, records)) {
+            std::cerr << "Could not write " << output.csv_path << "\n";
+            return 1;
+        }
+        std::cout << "Results written to " << output.csv_path << "\n";
+    }
+    if (!output.baseline_path.empty()) {
+        std::vector<BenchmarkRecord> baseline;
+        if (!readJsonReport(output.baseline_path, baseline)) {
+            std::cerr << "Could not read baseline " << output.baseline_path << "\n";
+            return 1;
+        }
+        if (compareWithBaseline(records, baseline, output)) {
+            return 2;
+        }
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -6,20 +6,129 @@
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <cstdlib>
+#include <algorithm>
 #include "functionality.hpp"
 #include "logging_profiling.hpp"
+#include "growth_tuner.hpp"
+
+static void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " <parameter>\n"
+              << "  -test [--json <file>] [--csv <file>] [--baseline <file.json>] [--repeat <n>] [--counters] [--max-regression <percent>]\n"
+              << "  -memory\n"
+              << "  -scaling [--threads <n>] [--arena-max <n>] [--runs <n>]\n"
+              << "  -tune [--output <header>] [--time-weight <0..1>] [--runs <n>]\n"
+              << "  -func" << std::endl;
+}
 
 int main(int argc, char* argv[])
 {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <parameter>" << std::endl;
+        printUsage(argv[0]);
         return 1;
     }
 
     std::string param = argv[1];
     if (param == "-test")
     {
-        StartBenchmark();
+        BenchmarkOutputOptions output;
+        for (int i = 2; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--json" && hasValue)
+            {
+                output.json_path = argv[++i];
+            }
+            else if (arg == "--csv" && hasValue)
+            {
+                output.csv_path = argv[++i];
+            }
+            else if (arg == "--baseline" && hasValue)
+            {
+                output.baseline_path = argv[++i];
+            }
+            else if (arg == "--counters")
+            {
+                output.counters = true;
+            }
+            else if (arg == "--repeat" && hasValue)
+            {
+                output.repeat = std::max(1, std::atoi(argv[++i]));
+            }
+            else if (arg == "--max-regression" && hasValue)
+            {
+                output.max_regression = std::strtod(argv[++i], nullptr) / 100.0;
+            }
+            else
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        return RunBenchmarks(output);
+    }
+
+    if (param == "-memory")
+    {
+        return StartMemoryBenchmark();
+    }
+
+    if (param == "-scaling")
+    {
+        ScalingOptions options;
+        for (int i = 2; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--threads" && hasValue)
+            {
+                options.max_threads = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+            }
+            else if (arg == "--arena-max" && hasValue)
+            {
+                options.arena_max = std::max(0, std::atoi(argv[++i]));
+            }
+            else if (arg == "--runs" && hasValue)
+            {
+                options.runs = std::max(1, std::atoi(argv[++i]));
+            }
+            else
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        return StartScalingBenchmark(options);
+    }
+
+    if (param == "-tune")
+    {
+        GrowthTuneOptions options;
+        for (int i = 2; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--output" && hasValue)
+            {
+                options.output_path = argv[++i];
+            }
+            else if (arg == "--time-weight" && hasValue)
+            {
+                options.time_weight = std::min(1.0, std::max(0.0, std::strtod(argv[++i], nullptr)));
+            }
+            else if (arg == "--runs" && hasValue)
+            {
+                options.runs = std::max(1, std::atoi(argv[++i]));
+            }
+            else
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        return RunGrowthTuning(options);
     }
 
     if (param == "-func")
@@ -29,4 +138,3 @@ int main(int argc, char* argv[])
 
     return 0;
 }
-
@@ -0,0 +1,485 @@
+#pragma once
+#include "rotcev.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace blck
+{
+    enum class map_mode
+    {
+        read_only,  // existing file, zero-copy view, no growth
+        read_write, // existing file or a new empty one
+        truncate    // always start from an empty file
+    };
+
+    enum class access_hint
+    {
+        normal,
+        sequential,
+        random,
+        will_need,
+        dont_need
+    };
+
+    // rotcev whose storage is a shared mapping of a file, for trivially copyable T.
+    // The file starts with a one page header (magic, element size, size,
+    // capacity) followed by the raw elements, so reopening a container is an
+    // mmap and costs nothing per element. Growth extends the file with
+    // ftruncate and the mapping with mremap; nothing is copied.
+    // The size is written to the header by flush() and on destruction.
+    // Errors from the system calls are thrown as std::system_error.
+    template <typename T, typename GrowthPolicy = default_growth>
+    class mapped_rotcev
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "mapped_rotcev stores raw bytes and needs a trivially copyable T");
+
+    public:
+        using ValueType = T;
+        using GrowthPolicyType = GrowthPolicy;
+        using Iterator = RotcevIterator<mapped_rotcev<T, GrowthPolicy>>;
+        using ConstIterator = RotcevIterator<mapped_rotcev<T, GrowthPolicy>, true>;
+
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+    private:
+        struct FileHeader
+        {
+            char m_Magic[8];
+            uint32_t m_Version;
+            uint32_t m_ElementSize;
+            uint64_t m_Size;
+            uint64_t m_Capacity;
+        };
+
+        static constexpr char Magic[8] = {'R', 'O', 'T', 'C', 'E', 'V', 'M', 'P'};
+        static constexpr uint32_t Version = 1;
+        // Keeps the elements page aligned
+        static constexpr size_t HeaderBytes = 4096;
+        // append() switches from memcpy to pwrite at this size
+        static constexpr size_t BulkWriteBytes = 256 * 1024;
+
+        [[noreturn]] void Fail(const char *What) const
+        {
+            throw std::system_error(errno, std::generic_category(), std::string("mapped_rotcev: ") + What + " " + m_Path);
+        }
+
+        static size_t FileBytes(size_t Capacity) noexcept
+        {
+            return HeaderBytes + Capacity * sizeof(T);
+        }
+
+        FileHeader *Header() const noexcept
+        {
+            return reinterpret_cast<FileHeader *>(m_Mapping);
+        }
+
+        T *Elements() const noexcept
+        {
+            return reinterpret_cast<T *>(static_cast<char *>(m_Mapping) + HeaderBytes);
+        }
+
+        void RequireWritable() const
+        {
+            if (m_ReadOnly)
+            {
+                throw std::logic_error("mapped_rotcev: " + m_Path + " is open read-only");
+            }
+        }
+
+        void Map(size_t Bytes)
+        {
+            int Protection = m_ReadOnly ? PROT_READ : (PROT_READ | PROT_WRITE);
+            void *Mapping = mmap(nullptr, Bytes, Protection, MAP_SHARED, m_File, 0);
+            if (Mapping == MAP_FAILED)
+            {
+                Fail("mmap");
+            }
+            m_Mapping = Mapping;
+            m_MappedBytes = Bytes;
+        }
+
+        // Resizes the file and the mapping to hold NewCapacity elements
+        void Remap(size_t NewCapacity)
+        {
+            RequireWritable();
+            size_t Bytes = FileBytes(NewCapacity);
+            if (ftruncate(m_File, static_cast<off_t>(Bytes)) != 0)
+            {
+                Fail("ftruncate");
+            }
+#if defined(__linux__)
+            void *Mapping = mremap(m_Mapping, m_MappedBytes, Bytes, MREMAP_MAYMOVE);
+            if (Mapping == MAP_FAILED)
+            {
+                Fail("mremap");
+            }
+            m_Mapping = Mapping;
+            m_MappedBytes = Bytes;
+#else
+            munmap(m_Mapping, m_MappedBytes);
+            Map(Bytes);
+#endif
+            m_Capacity = NewCapacity;
+            Header()->m_Capacity = NewCapacity;
+        }
+
+        void WriteAt(size_t Offset, const void *Source, size_t Bytes)
+        {
+            const char *Cursor = static_cast<const char *>(Source);
+            while (Bytes > 0)
+            {
+                ssize_t Written = pwrite(m_File, Cursor, Bytes, static_cast<off_t>(Offset));
+                if (Written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    Fail("pwrite");
+                }
+                Cursor += Written;
+                Offset += static_cast<size_t>(Written);
+                Bytes -= static_cast<size_t>(Written);
+            }
+        }
+
+        void ReserveForAppend(size_t Count)
+        {
+            if (m_Capacity < m_Size + Count)
+            {
+                Remap(GrowthPolicy::template next_capacity<T>(m_Size, m_Size + Count));
+            }
+        }
+
+        void Close() noexcept
+        {
+            if (m_Mapping)
+            {
+                if (!m_ReadOnly)
+                {
+                    Header()->m_Size = m_Size;
+                }
+                munmap(m_Mapping, m_MappedBytes);
+            }
+            if (m_File >= 0)
+            {
+                ::close(m_File);
+            }
+            m_Mapping = nullptr;
+            m_MappedBytes = 0;
+            m_File = -1;
+            m_Size = 0;
+            m_Capacity = 0;
+        }
+
+        void StealFrom(mapped_rotcev &Other) noexcept
+        {
+            m_Path = std::move(Other.m_Path);
+            m_File = Other.m_File;
+            m_Mapping = Other.m_Mapping;
+            m_MappedBytes = Other.m_MappedBytes;
+            m_Size = Other.m_Size;
+            m_Capacity = Other.m_Capacity;
+            m_ReadOnly = Other.m_ReadOnly;
+            Other.m_File = -1;
+            Other.m_Mapping = nullptr;
+            Other.m_MappedBytes = 0;
+            Other.m_Size = 0;
+            Other.m_Capacity = 0;
+        }
+
+    public:
+        mapped_rotcev(const std::string &Path, map_mode Mode = map_mode::read_write)
+            : m_Path(Path), m_ReadOnly(Mode == map_mode::read_only)
+        {
+            int Flags = m_ReadOnly ? O_RDONLY : (O_RDWR | O_CREAT | (Mode == map_mode::truncate ? O_TRUNC : 0));
+            m_File = ::open(Path.c_str(), Flags | O_CLOEXEC, 0644);
+            if (m_File < 0)
+            {
+                Fail("open");
+            }
+
+            try
+            {
+                struct stat Info;
+                if (fstat(m_File, &Info) != 0)
+                {
+                    Fail("fstat");
+                }
+
+                if (Info.st_size == 0 && !m_ReadOnly)
+                {
+                    // New file, write an empty header
+                    if (ftruncate(m_File, static_cast<off_t>(FileBytes(0))) != 0)
+                    {
+                        Fail("ftruncate");
+                    }
+                    Map(FileBytes(0));
+                    std::memcpy(Header()->m_Magic, Magic, sizeof(Magic));
+                    Header()->m_Version = Version;
+                    Header()->m_ElementSize = sizeof(T);
+                    Header()->m_Size = 0;
+                    Header()->m_Capacity = 0;
+                    return;
+                }
+
+                if (static_cast<size_t>(Info.st_size) < HeaderBytes)
+                {
+                    throw std::runtime_error("mapped_rotcev: " + Path + " is too small to be a mapped_rotcev file");
+                }
+                Map(static_cast<size_t>(Info.st_size));
+                const FileHeader *Existing = Header();
+                if (std::memcmp(Existing->m_Magic, Magic, sizeof(Magic)) != 0 || Existing->m_Version != Version)
+                {
+                    throw std::runtime_error("mapped_rotcev: " + Path + " is not a mapped_rotcev file");
+                }
+                if (Existing->m_ElementSize != sizeof(T))
+                {
+                    throw std::runtime_error("mapped_rotcev: " + Path + " holds elements of a different size");
+                }
+                // Divided rather than multiplied, a corrupt capacity must not wrap around
+                if (Existing->m_Capacity > (m_MappedBytes - HeaderBytes) / sizeof(T) || Existing->m_Size > Existing->m_Capacity)
+                {
+                    throw std::runtime_error("mapped_rotcev: " + Path + " is truncated");
+                }
+                m_Size = Existing->m_Size;
+                m_Capacity = Existing->m_Capacity;
+            }
+            catch (...)
+            {
+                Close();
+                throw;
+            }
+        }
+
+        ~mapped_rotcev()
+        {
+            Close();
+        }
+
+        mapped_rotcev(const mapped_rotcev &) = delete;
+        mapped_rotcev &operator=(const mapped_rotcev &) = delete;
+
+        mapped_rotcev(mapped_rotcev &&other) noexcept
+        {
+            StealFrom(other);
+        }
+
+        mapped_rotcev &operator=(mapped_rotcev &&other) noexcept
+        {
+            if (this != &other)
+            {
+                Close();
+                StealFrom(other);
+            }
+            return *this;
+        }
+
+        Iterator begin() noexcept
+        {
+            return Iterator(Elements());
+        }
+        Iterator end() noexcept
+        {
+            return Iterator(Elements() + m_Size);
+        }
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(Elements());
+        }
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator(Elements() + m_Size);
+        }
+        ConstIterator cbegin() const noexcept
+        {
+            return ConstIterator(Elements());
+        }
+        ConstIterator cend() const noexcept
+        {
+            return ConstIterator(Elements() + m_Size);
+        }
+
+        void push_back(const T &Value)
+        {
+            RequireWritable();
+            T Copy = Value; // Value may live in the mapping mremap is about to move
+            ReserveForAppend(1);
+            Elements()[m_Size++] = Copy;
+        }
+
+        // Appends Count elements with at most one remap
+        void append(const T *First, size_t Count)
+        {
+            RequireWritable();
+            if (Count == 0)
+            {
+                return;
+            }
+            if (First >= Elements() && First < Elements() + m_Capacity)
+            {
+                // Source inside our own mapping, go through a temporary copy
+                rotcev<T> Copy;
+                Copy.append(First, First + Count);
+                append(Copy.data(), Count);
+                return;
+            }
+            ReserveForAppend(Count);
+            size_t Bytes = Count * sizeof(T);
+            if (Bytes >= BulkWriteBytes)
+            {
+                // Large blocks go through the file descriptor: the shared mapping sees
+                // the same page cache, and it skips a page fault per 4 KiB of memcpy
+                WriteAt(FileBytes(m_Size), First, Bytes);
+            }
+            else
+            {
+                std::memcpy(static_cast<void *>(Elements() + m_Size), First, Bytes);
+            }
+            m_Size += Count;
+        }
+
+        inline void pop_back() noexcept
+        {
+            if (m_Size > 0)
+            {
+                --m_Size;
+            }
+        }
+
+        void clear() noexcept
+        {
+            m_Size = 0;
+        }
+
+        // New elements are zero (fresh file pages) or whatever a previous clear() left behind
+        void resize(size_t NewSize)
+        {
+            RequireWritable();
+            if (NewSize > m_Capacity)
+            {
+                Remap(NewSize);
+            }
+            m_Size = NewSize;
+        }
+
+        void reserve(size_t NewCapacity)
+        {
+            if (NewCapacity > m_Capacity)
+            {
+                Remap(NewCapacity);
+            }
+        }
+
+        // Shrinks the file to the current size
+        void shrink_to_fit()
+        {
+            if (m_Capacity > m_Size)
+            {
+                Remap(m_Size);
+            }
+        }
+
+        T &operator[](size_t Index) noexcept
+        {
+            return Elements()[Index];
+        }
+
+        const T &operator[](size_t Index) const noexcept
+        {
+            return Elements()[Index];
+        }
+
+        inline size_t size() const noexcept
+        {
+            return m_Size;
+        }
+
+        inline size_t capacity() const noexcept
+        {
+            return m_Capacity;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+        inline bool read_only() const noexcept
+        {
+            return m_ReadOnly;
+        }
+
+        inline T *data() noexcept
+        {
+            return Elements();
+        }
+
+        inline const T *data() const noexcept
+        {
+            return Elements();
+        }
+
+        const std::string &path() const noexcept
+        {
+            return m_Path;
+        }
+
+        // Records the size in the header and writes dirty pages back to the file.
+        // Async only schedules the write-back.
+        void flush(bool Async = false)
+        {
+            if (m_ReadOnly)
+            {
+                return;
+            }
+            Header()->m_Size = m_Size;
+            if (msync(m_Mapping, FileBytes(m_Size), Async ? MS_ASYNC : MS_SYNC) != 0)
+            {
+                Fail("msync");
+            }
+        }
+
+        // Tells the kernel how the elements are going to be accessed
+        void advise(access_hint Hint)
+        {
+            int Advice = MADV_NORMAL;
+            switch (Hint)
+            {
+            case access_hint::sequential: Advice = MADV_SEQUENTIAL; break;
+            case access_hint::random: Advice = MADV_RANDOM; break;
+            case access_hint::will_need: Advice = MADV_WILLNEED; break;
+            case access_hint::dont_need: Advice = MADV_DONTNEED; break;
+            default: break;
+            }
+            if (madvise(m_Mapping, m_MappedBytes, Advice) != 0)
+            {
+                Fail("madvise");
+            }
+        }
+
+    private:
+        std::string m_Path;
+        int m_File = -1;
+        void *m_Mapping = nullptr;
+        size_t m_MappedBytes = 0;
+        size_t m_Size = 0;
+        size_t m_Capacity = 0;
+        bool m_ReadOnly = false;
+    };
+
+} // namespace blck
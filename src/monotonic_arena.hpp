@@ -0,0 +1,199 @@
+#pragma once
+#include <malloc.h>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <algorithm>
+#include "allocation_size.hpp"
+
+namespace blck
+{
+    // Bump-pointer arena for short-lived containers.
+    // Memory is carved out of large blocks and is never handed back one
+    // allocation at a time; instead the whole arena is rewound with reset()
+    // or returned to the system with release().
+    class monotonic_arena
+    {
+    public:
+        explicit monotonic_arena(size_t InitialBlockSize = 64 * 1024)
+            : m_NextBlockSize(std::max(InitialBlockSize, MinimumBlockSize))
+        {}
+
+        // Serve allocations from a caller-owned buffer first, spill to the heap afterwards
+        monotonic_arena(void *Buffer, size_t BufferSize)
+            : m_Cursor(static_cast<char *>(Buffer)),
+              m_End(static_cast<char *>(Buffer) + BufferSize),
+              m_InitialBuffer(static_cast<char *>(Buffer)),
+              m_InitialBufferSize(BufferSize),
+              m_NextBlockSize(std::max(BufferSize * 2, MinimumBlockSize))
+        {}
+
+        ~monotonic_arena()
+        {
+            release();
+        }
+
+        monotonic_arena(const monotonic_arena &) = delete;
+        monotonic_arena &operator=(const monotonic_arena &) = delete;
+
+        void *allocate(size_t Bytes, size_t Alignment = alignof(std::max_align_t))
+        {
+            char *Aligned = AlignUp(m_Cursor, Alignment);
+            // Compared as sizes, Aligned + Bytes could wrap past the end of the address space
+            if (!m_Cursor || Aligned > m_End || Bytes > static_cast<size_t>(m_End - Aligned))
+            {
+                if (Bytes > SIZE_MAX - Alignment - sizeof(BlockHeader))
+                {
+                    throw std::bad_alloc();
+                }
+                AllocateNewBlock(Bytes + Alignment);
+                Aligned = AlignUp(m_Cursor, Alignment);
+            }
+            m_Cursor = Aligned + Bytes;
+            m_BytesAllocated += Bytes;
+            return Aligned;
+        }
+
+        // Rewind to the start of the newest (largest) block and free the others.
+        // Everything handed out so far becomes invalid.
+        void reset() noexcept
+        {
+            if (!m_Blocks)
+            {
+                m_Cursor = m_InitialBuffer;
+                m_End = m_InitialBuffer + m_InitialBufferSize;
+                m_BytesAllocated = 0;
+                return;
+            }
+
+            FreeBlocks(m_Blocks->m_Next);
+            m_Blocks->m_Next = nullptr;
+            m_BytesReserved = m_Blocks->m_Size;
+            m_Cursor = BlockData(m_Blocks);
+            m_End = reinterpret_cast<char *>(m_Blocks) + m_Blocks->m_Size;
+            m_BytesAllocated = 0;
+        }
+
+        // Return every block to the system. Everything handed out so far becomes invalid.
+        void release() noexcept
+        {
+            FreeBlocks(m_Blocks);
+            m_Blocks = nullptr;
+            m_Cursor = m_InitialBuffer;
+            m_End = m_InitialBuffer + m_InitialBufferSize;
+            m_BytesAllocated = 0;
+            m_BytesReserved = 0;
+        }
+
+        size_t bytes_allocated() const noexcept
+        {
+            return m_BytesAllocated;
+        }
+
+        size_t bytes_reserved() const noexcept
+        {
+            return m_BytesReserved + m_InitialBufferSize;
+        }
+
+    private:
+        struct BlockHeader
+        {
+            BlockHeader *m_Next;
+            size_t m_Size;
+        };
+
+        static char *AlignUp(char *Ptr, size_t Alignment) noexcept
+        {
+            uintptr_t Address = reinterpret_cast<uintptr_t>(Ptr);
+            return reinterpret_cast<char *>((Address + Alignment - 1) & ~(uintptr_t)(Alignment - 1));
+        }
+
+        static char *BlockData(BlockHeader *Block) noexcept
+        {
+            return reinterpret_cast<char *>(Block) + sizeof(BlockHeader);
+        }
+
+        static void FreeBlocks(BlockHeader *Block) noexcept
+        {
+            while (Block)
+            {
+                BlockHeader *Next = Block->m_Next;
+                free(Block);
+                Block = Next;
+            }
+        }
+
+        void AllocateNewBlock(size_t MinimumBytes)
+        {
+            size_t BlockSize = std::max(m_NextBlockSize, MinimumBytes + sizeof(BlockHeader));
+            BlockHeader *Block = static_cast<BlockHeader *>(malloc(BlockSize));
+            if (!Block)
+            {
+                throw std::bad_alloc();
+            }
+            Block->m_Next = m_Blocks;
+            Block->m_Size = BlockSize;
+            m_Blocks = Block;
+            m_BytesReserved += BlockSize;
+
+            m_Cursor = BlockData(Block);
+            m_End = reinterpret_cast<char *>(Block) + BlockSize;
+            m_NextBlockSize = BlockSize * 2;
+        }
+
+    private:
+        static constexpr size_t MinimumBlockSize = 4096;
+
+        BlockHeader *m_Blocks = nullptr;
+        char *m_Cursor = nullptr;
+        char *m_End = nullptr;
+        char *m_InitialBuffer = nullptr;
+        size_t m_InitialBufferSize = 0;
+        size_t m_NextBlockSize = MinimumBlockSize;
+        size_t m_BytesAllocated = 0;
+        size_t m_BytesReserved = 0;
+    };
+
+    // Allocator adaptor so rotcev (or any allocator-aware container) can draw from a monotonic_arena.
+    // deallocate() is a no-op, memory comes back when the arena is reset or released.
+    template <typename T>
+    struct arena_allocator
+    {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        arena_allocator(monotonic_arena &Arena) noexcept
+            : m_Arena(&Arena) {}
+
+        template <typename U>
+        arena_allocator(const arena_allocator<U> &Other) noexcept
+            : m_Arena(Other.m_Arena) {}
+
+        T *allocate(size_t Count)
+        {
+            detail::CheckAllocationCount<T>(Count);
+            return static_cast<T *>(m_Arena->allocate(sizeof(T) * Count, alignof(T)));
+        }
+
+        void deallocate(T *, size_t) noexcept
+        {}
+
+        template <typename U>
+        bool operator==(const arena_allocator<U> &Other) const noexcept
+        {
+            return m_Arena == Other.m_Arena;
+        }
+
+        template <typename U>
+        bool operator!=(const arena_allocator<U> &Other) const noexcept
+        {
+            return m_Arena != Other.m_Arena;
+        }
+
+        monotonic_arena *m_Arena;
+    };
+
+} // namespace blck
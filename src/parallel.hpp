@@ -0,0 +1,192 @@
+#pragma once
+#include "rotcev.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace blck
+{
+    // Parallel algorithms over index ranges and rotcev, running on a thread_pool.
+    // The range is cut into chunks of Grain elements (0 picks one automatically).
+    // Chunks are handed out by recursive halving, so idle workers steal big
+    // pieces first. Chunk boundaries only depend on the size and the grain,
+    // which keeps parallel_reduce results reproducible run to run.
+
+    namespace detail
+    {
+        // Below this many elements per chunk the task overhead starts to show
+        inline constexpr size_t MinimumParallelGrain = 1024;
+
+        inline size_t ResolveGrain(size_t Count, size_t Grain, const thread_pool &Pool) noexcept
+        {
+            if (Grain > 0)
+            {
+                return Grain;
+            }
+            size_t Automatic = Count / (Pool.size() * 8);
+            return Automatic > MinimumParallelGrain ? Automatic : MinimumParallelGrain;
+        }
+
+        // Calls Body(First, Last) for every chunk index in [First, Last),
+        // pushing the upper halves to the pool and keeping the lowest chunk
+        template <typename F>
+        void SplitChunks(task_group &Group, size_t First, size_t Last, const F &Body)
+        {
+            while (Last - First > 1)
+            {
+                size_t Middle = First + (Last - First) / 2;
+                Group.run([&Group, &Body, Middle, Last] { SplitChunks(Group, Middle, Last, Body); });
+                Last = Middle;
+            }
+            Body(First, Last);
+        }
+
+        // Calls ChunkBody(Chunk, Begin, End) for each Grain sized piece of [0, Count)
+        template <typename F>
+        void ForEachChunk(thread_pool &Pool, size_t Count, size_t Grain, const F &ChunkBody)
+        {
+            if (Count == 0)
+            {
+                return;
+            }
+            size_t ChunkCount = (Count + Grain - 1) / Grain;
+            auto RunChunks = [&](size_t First, size_t Last) {
+                for (size_t Chunk = First; Chunk < Last; Chunk++)
+                {
+                    size_t Begin = Chunk * Grain;
+                    size_t End = (Begin + Grain < Count) ? Begin + Grain : Count;
+                    ChunkBody(Chunk, Begin, End);
+                }
+            };
+
+            if (ChunkCount == 1 || Pool.size() == 1)
+            {
+                RunChunks(0, ChunkCount);
+                return;
+            }
+            task_group Group(Pool);
+            SplitChunks(Group, 0, ChunkCount, RunChunks);
+            Group.wait();
+        }
+    }
+
+    // Body(Index) for every Index in [Begin, End)
+    template <typename F>
+    void parallel_for(size_t Begin, size_t End, F Body, size_t Grain = 0, thread_pool &Pool = thread_pool::global())
+    {
+        size_t Count = End > Begin ? End - Begin : 0;
+        detail::ForEachChunk(Pool, Count, detail::ResolveGrain(Count, Grain, Pool), [&](size_t, size_t From, size_t To) {
+            for (size_t i = From; i < To; i++)
+            {
+                Body(Begin + i);
+            }
+        });
+    }
+
+    // Body(Element) for every element of Container
+    template <typename T, typename Alloc, typename GrowthPolicy, typename F>
+    void parallel_for(rotcev<T, Alloc, GrowthPolicy> &Container, F Body, size_t Grain = 0, thread_pool &Pool = thread_pool::global())
+    {
+        T *Data = Container.data();
+        size_t Count = Container.size();
+        detail::ForEachChunk(Pool, Count, detail::ResolveGrain(Count, Grain, Pool), [&](size_t, size_t From, size_t To) {
+            for (size_t i = From; i < To; i++)
+            {
+                Body(Data[i]);
+            }
+        });
+    }
+
+    // Folds every chunk with Reduce(Result, Element) starting from Identity,
+    // then folds the chunk results in order with Combine(Result, Result).
+    // Identity has to be neutral for Combine (0 for a sum, 1 for a product).
+    template <typename T, typename Alloc, typename GrowthPolicy, typename R, typename ReduceOp, typename CombineOp>
+    R parallel_reduce(const rotcev<T, Alloc, GrowthPolicy> &Container, R Identity, ReduceOp Reduce, CombineOp Combine,
+                      size_t Grain = 0, thread_pool &Pool = thread_pool::global())
+    {
+        const T *Data = Container.data();
+        size_t Count = Container.size();
+        Grain = detail::ResolveGrain(Count, Grain, Pool);
+
+        rotcev<R> Partials;
+        Partials.resize((Count + Grain - 1) / Grain, Identity);
+        detail::ForEachChunk(Pool, Count, Grain, [&](size_t Chunk, size_t From, size_t To) {
+            R Local = Identity;
+            for (size_t i = From; i < To; i++)
+            {
+                Local = Reduce(std::move(Local), Data[i]);
+            }
+            Partials[Chunk] = std::move(Local);
+        });
+
+        R Result = std::move(Identity);
+        for (R &Partial : Partials)
+        {
+            Result = Combine(std::move(Result), std::move(Partial));
+        }
+        return Result;
+    }
+
+    // Same operation for elements and chunk results, e.g. std::plus<>()
+    template <typename T, typename Alloc, typename GrowthPolicy, typename R, typename Op>
+    R parallel_reduce(const rotcev<T, Alloc, GrowthPolicy> &Container, R Identity, Op Reduce,
+                      size_t Grain = 0, thread_pool &Pool = thread_pool::global())
+    {
+        return parallel_reduce(Container, std::move(Identity), Reduce, Reduce, Grain, Pool);
+    }
+
+    // Out[i] = Operation(In[i]), Out is resized to In.size()
+    template <typename T, typename AllocIn, typename GrowthIn, typename U, typename AllocOut, typename GrowthOut, typename Op>
+    void parallel_transform(const rotcev<T, AllocIn, GrowthIn> &In, rotcev<U, AllocOut, GrowthOut> &Out, Op Operation,
+                            size_t Grain = 0, thread_pool &Pool = thread_pool::global())
+    {
+        Out.resize_for_overwrite(In.size());
+        const T *Source = In.data();
+        U *Dest = Out.data();
+        size_t Count = In.size();
+        detail::ForEachChunk(Pool, Count, detail::ResolveGrain(Count, Grain, Pool), [&](size_t, size_t From, size_t To) {
+            for (size_t i = From; i < To; i++)
+            {
+                Dest[i] = Operation(Source[i]);
+            }
+        });
+    }
+
+    // Sorts the chunks in parallel, then merges neighbouring runs pairwise,
+    // doubling the run length every round. The final merge is a single
+    // std::inplace_merge, so expect roughly log2(threads) fold speedups.
+    template <typename T, typename Alloc, typename GrowthPolicy, typename Compare = std::less<>>
+    void parallel_sort(rotcev<T, Alloc, GrowthPolicy> &Container, Compare Comp = Compare(),
+                       size_t Grain = 0, thread_pool &Pool = thread_pool::global())
+    {
+        T *Data = Container.data();
+        size_t Count = Container.size();
+        Grain = detail::ResolveGrain(Count, Grain, Pool);
+        size_t ChunkCount = (Count + Grain - 1) / Grain;
+        if (ChunkCount <= 1 || Pool.size() == 1)
+        {
+            std::sort(Data, Data + Count, Comp);
+            return;
+        }
+
+        detail::ForEachChunk(Pool, Count, Grain, [&](size_t, size_t From, size_t To) {
+            std::sort(Data + From, Data + To, Comp);
+        });
+
+        for (size_t RunChunks = 1; RunChunks < ChunkCount; RunChunks *= 2)
+        {
+            size_t RunLength = RunChunks * Grain;
+            size_t PairCount = (ChunkCount + 2 * RunChunks - 1) / (2 * RunChunks);
+            detail::ForEachChunk(Pool, PairCount, 1, [&](size_t Pair, size_t, size_t) {
+                size_t Begin = Pair * 2 * RunLength;
+                size_t Middle = Begin + RunLength;
+                size_t End = Middle + RunLength;
+                if (Middle < Count)
+                {
+                    std::inplace_merge(Data + Begin, Data + Middle, Data + (End < Count ? End : Count), Comp);
+                }
+            });
+        }
+    }
+
+} // namespace blck
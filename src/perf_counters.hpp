@@ -0,0 +1,217 @@
+#pragma once
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace blck
+{
+    namespace bench
+    {
+        // Events collected by perf_counters, in storage order
+        enum class counter : size_t
+        {
+            cycles,
+            instructions,
+            l1d_misses,
+            llc_misses,
+            branch_misses,
+            page_faults
+        };
+
+        constexpr size_t counter_count = 6;
+
+        inline const char *counter_name(counter Counter) noexcept
+        {
+            static const char *const Names[counter_count] = {"cycles", "instructions", "l1d_misses",
+                                                             "llc_misses", "branch_misses", "page_faults"};
+            return Names[static_cast<size_t>(Counter)];
+        }
+
+        // One reading (or the difference of two) of every counter; counters the
+        // kernel did not open stay invalid and read as 0
+        struct counter_values
+        {
+            std::array<uint64_t, counter_count> value{};
+            std::array<bool, counter_count> valid{};
+
+            uint64_t operator[](counter Counter) const noexcept
+            {
+                return value[static_cast<size_t>(Counter)];
+            }
+
+            bool has(counter Counter) const noexcept
+            {
+                return valid[static_cast<size_t>(Counter)];
+            }
+
+            bool any() const noexcept
+            {
+                for (bool Valid : valid)
+                {
+                    if (Valid)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Instructions per cycle, 0 without both counters
+            double ipc() const noexcept
+            {
+                return has(counter::cycles) && has(counter::instructions) && value[0] > 0
+                           ? static_cast<double>(value[1]) / static_cast<double>(value[0])
+                           : 0.0;
+            }
+
+            counter_values &operator+=(const counter_values &Other) noexcept
+            {
+                for (size_t i = 0; i < counter_count; i++)
+                {
+                    value[i] += Other.value[i];
+                    valid[i] = valid[i] || Other.valid[i];
+                }
+                return *this;
+            }
+
+            friend counter_values operator-(const counter_values &End, const counter_values &Start) noexcept
+            {
+                counter_values Delta;
+                for (size_t i = 0; i < counter_count; i++)
+                {
+                    Delta.valid[i] = End.valid[i] && Start.valid[i];
+                    Delta.value[i] = Delta.valid[i] && End.value[i] > Start.value[i] ? End.value[i] - Start.value[i] : 0;
+                }
+                return Delta;
+            }
+        };
+
+        // Hardware and software event counters of the calling thread through
+        // Linux perf_event_open. Every event is opened on its own, so a kernel or
+        // VM without a PMU still provides the software ones (page faults), and a
+        // kernel that forbids perf entirely leaves the collector unavailable
+        // instead of failing. Counters run from construction; measure a region as
+        // the difference of two read() calls.
+        class perf_counters
+        {
+        public:
+            perf_counters()
+            {
+                m_Fds.fill(-1);
+#if defined(__linux__)
+                OpenEvent(counter::cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+                OpenEvent(counter::instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+                OpenEvent(counter::l1d_misses, PERF_TYPE_HW_CACHE,
+                          PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+                OpenEvent(counter::llc_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+                OpenEvent(counter::branch_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+                OpenEvent(counter::page_faults, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+#else
+                m_Status = "perf_event_open needs Linux";
+#endif
+            }
+
+            ~perf_counters()
+            {
+#if defined(__linux__)
+                for (int Fd : m_Fds)
+                {
+                    if (Fd >= 0)
+                    {
+                        close(Fd);
+                    }
+                }
+#endif
+            }
+
+            perf_counters(const perf_counters &) = delete;
+            perf_counters &operator=(const perf_counters &) = delete;
+
+            // True when at least one event could be opened
+            bool available() const noexcept
+            {
+                for (int Fd : m_Fds)
+                {
+                    if (Fd >= 0)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool has(counter Counter) const noexcept
+            {
+                return m_Fds[static_cast<size_t>(Counter)] >= 0;
+            }
+
+            // Which events are missing and why, empty when all opened
+            const std::string &status() const noexcept
+            {
+                return m_Status;
+            }
+
+            // Current totals, scaled up when the kernel multiplexed an event
+            counter_values read() const noexcept
+            {
+                counter_values Values;
+#if defined(__linux__)
+                for (size_t i = 0; i < counter_count; i++)
+                {
+                    uint64_t Raw[3] = {}; // value, time enabled, time running
+                    if (m_Fds[i] < 0 || ::read(m_Fds[i], Raw, sizeof(Raw)) != static_cast<ssize_t>(sizeof(Raw)))
+                    {
+                        continue;
+                    }
+                    Values.valid[i] = true;
+                    Values.value[i] = Raw[2] > 0 && Raw[2] < Raw[1]
+                                          ? static_cast<uint64_t>(static_cast<double>(Raw[0]) * static_cast<double>(Raw[1]) /
+                                                                static_cast<double>(Raw[2]))
+                                          : Raw[0];
+                }
+#endif
+                return Values;
+            }
+
+        private:
+#if defined(__linux__)
+            void OpenEvent(counter Counter, uint32_t Type, uint64_t Config)
+            {
+                perf_event_attr Attributes;
+                std::memset(&Attributes, 0, sizeof(Attributes));
+                Attributes.size = sizeof(Attributes);
+                Attributes.type = Type;
+                Attributes.config = Config;
+                Attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                Attributes.exclude_hv = 1;
+                // Page faults are taken in the kernel, keep them unless perf_event_paranoid forbids it
+                Attributes.exclude_kernel = Type != PERF_TYPE_SOFTWARE;
+                int Fd = static_cast<int>(syscall(SYS_perf_event_open, &Attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+                if (Fd < 0 && !Attributes.exclude_kernel)
+                {
+                    Attributes.exclude_kernel = 1;
+                    Fd = static_cast<int>(syscall(SYS_perf_event_open, &Attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+                }
+                if (Fd < 0)
+                {
+                    m_Status += std::string(m_Status.empty() ? "" : ", ") + counter_name(Counter) + ": " + std::strerror(errno);
+                }
+                m_Fds[static_cast<size_t>(Counter)] = Fd;
+            }
+#endif
+
+            std::array<int, counter_count> m_Fds;
+            std::string m_Status;
+        };
+    }
+
+} // namespace blck
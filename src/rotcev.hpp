@@ -1,71 +1,163 @@
 #pragma once
 #include <malloc.h>
+#include <cstdint>
 #include <memory>
 #include <iostream>
 #include <cstring>
+#include <functional>
 #include <chrono>
+#include <algorithm>
 #include <array>
+#include <new>
+#include <type_traits>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "allocation_size.hpp"
+#include "growth_policy.hpp"
+#include "rotcev_stats.hpp"
 
 namespace blck
 {
-    template <typename Vector>
+    // Contiguous random-access iterator shared by the rotcev containers.
+    // IsConst selects the const_iterator flavour.
+    template <typename Vector, bool IsConst = false>
     class RotcevIterator
     {
     public:
         using ValueType = typename Vector::ValueType;
-        using PointerType = ValueType*;
-        using ReferenceType = ValueType&;
+        using PointerType = std::conditional_t<IsConst, const ValueType *, ValueType *>;
+        using ReferenceType = std::conditional_t<IsConst, const ValueType &, ValueType &>;
+
+        using iterator_category = std::random_access_iterator_tag;
+#if defined(__cpp_lib_concepts)
+        using iterator_concept = std::contiguous_iterator_tag;
+#endif
+        using value_type = std::remove_cv_t<ValueType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = PointerType;
+        using reference = ReferenceType;
     public:
-        RotcevIterator(PointerType ptr)
+        RotcevIterator() noexcept
+            : m_Ptr(nullptr) {}
+
+        RotcevIterator(PointerType ptr) noexcept
             : m_Ptr(ptr) {}
 
-        RotcevIterator& operator++()
+        // iterator -> const_iterator
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        RotcevIterator(const RotcevIterator<Vector, OtherConst> &Other) noexcept
+            : m_Ptr(Other.operator->()) {}
+
+        RotcevIterator& operator++() noexcept
         {
             m_Ptr++;
             return *this;
         }
 
-        RotcevIterator operator++(int)
+        RotcevIterator operator++(int) noexcept
         {
             RotcevIterator iterator = *this;
             ++(*this);
             return iterator;
         }
 
-        RotcevIterator& operator--()
+        RotcevIterator& operator--() noexcept
         {
             m_Ptr--;
             return *this;
         }
 
-        RotcevIterator operator--(int)
+        RotcevIterator operator--(int) noexcept
         {
             RotcevIterator iterator = *this;
             --(*this);
             return iterator;
         }
 
-        ReferenceType operator[](int Index)
+        RotcevIterator& operator+=(difference_type Offset) noexcept
+        {
+            m_Ptr += Offset;
+            return *this;
+        }
+
+        RotcevIterator& operator-=(difference_type Offset) noexcept
+        {
+            m_Ptr -= Offset;
+            return *this;
+        }
+
+        RotcevIterator operator+(difference_type Offset) const noexcept
+        {
+            return RotcevIterator(m_Ptr + Offset);
+        }
+
+        friend RotcevIterator operator+(difference_type Offset, const RotcevIterator& Iterator) noexcept
+        {
+            return Iterator + Offset;
+        }
+
+        RotcevIterator operator-(difference_type Offset) const noexcept
+        {
+            return RotcevIterator(m_Ptr - Offset);
+        }
+
+        // Differences and comparisons also mix iterator and const_iterator
+        template <bool OtherConst>
+        difference_type operator-(const RotcevIterator<Vector, OtherConst>& Other) const noexcept
+        {
+            return m_Ptr - Other.operator->();
+        }
+
+        ReferenceType operator[](difference_type Index) const noexcept
         {
             return *(m_Ptr + Index);
         }
 
-        bool operator==(const RotcevIterator& Other) const
+        template <bool OtherConst>
+        bool operator==(const RotcevIterator<Vector, OtherConst>& Other) const noexcept
         {
-            return m_Ptr == Other.m_Ptr;
+            return m_Ptr == Other.operator->();
         }
 
-        bool operator!=(const RotcevIterator& Other) const
+        template <bool OtherConst>
+        bool operator!=(const RotcevIterator<Vector, OtherConst>& Other) const noexcept
         {
-            return m_Ptr != Other.m_Ptr;
+            return m_Ptr != Other.operator->();
         }
 
-        ReferenceType operator*() const
+        template <bool OtherConst>
+        bool operator<(const RotcevIterator<Vector, OtherConst>& Other) const noexcept
+        {
+            return m_Ptr < Other.operator->();
+        }
+
+        template <bool OtherConst>
+        bool operator>(const RotcevIterator<Vector, OtherConst>& Other) const noexcept
+        {
+            return m_Ptr > Other.operator->();
+        }
+
+        template <bool OtherConst>
+        bool operator<=(const RotcevIterator<Vector, OtherConst>& Other) const noexcept
+        {
+            return m_Ptr <= Other.operator->();
+        }
+
+        template <bool OtherConst>
+        bool operator>=(const RotcevIterator<Vector, OtherConst>& Other) const noexcept
+        {
+            return m_Ptr >= Other.operator->();
+        }
+
+        ReferenceType operator*() const noexcept
         {
             return *m_Ptr;
         }
         
-        PointerType operator->() const
+        PointerType operator->() const noexcept
         {
             return m_Ptr;
         }
@@ -74,121 +166,577 @@ namespace blck
         PointerType m_Ptr;
     };
 
+    // Default allocator for rotcev, a thin wrapper over malloc/free so the
+    // container keeps its original allocation behaviour
+    template <typename T>
+    struct malloc_allocator
+    {
+        using value_type = T;
+
+        malloc_allocator() noexcept = default;
+
+        template <typename U>
+        malloc_allocator(const malloc_allocator<U> &) noexcept {}
+
+        T *allocate(size_t Count)
+        {
+            detail::CheckAllocationCount<T>(Count);
+            void *Memory = malloc(sizeof(T) * Count);
+            if (!Memory)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(Memory);
+        }
+
+        void deallocate(T *Ptr, size_t) noexcept
+        {
+            free(Ptr);
+        }
+
+        // Growth path for trivially relocatable T, lets realloc extend the block in place
+        T *reallocate(T *Ptr, size_t, size_t NewCount)
+        {
+            detail::CheckAllocationCount<T>(NewCount);
+            void *Memory = realloc(static_cast<void *>(Ptr), sizeof(T) * NewCount);
+            if (!Memory)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(Memory);
+        }
+
+        template <typename U>
+        bool operator==(const malloc_allocator<U> &) const noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const malloc_allocator<U> &) const noexcept
+        {
+            return false;
+        }
+    };
+
     // For header-only library, we don't need export macros
     // The template will be compiled directly into the user's code
 
     // TODO: Container improvements and missing functionality
-    // TODO: Add size() and capacity() methods for standard container interface
-    // TODO: Add const versions of operator[] for read-only access
-    // TODO: Implement iterators (begin(), end(), cbegin(), cend()) for range-based loops
-    // TODO: Add emplace_back() for in-place construction to avoid unnecessary copies
-    // TODO: Add pop_back() method for removing last element
-    // TODO: Add clear() method to remove all elements while keeping allocated memory
-    // TODO: Add reserve() method for pre-allocating memory to avoid reallocations
-    // TODO: Add shrink_to_fit() method to reduce capacity to match size
-    // TODO: Add empty() method to check if container has no elements
     // TODO: Add front() and back() methods for accessing first and last elements
-    // TODO: Add copy constructor and copy assignment operator
-    // TODO: Add move constructor and move assignment operator
     // TODO: Add comparison operators (==, !=, <, <=, >, >=) for container comparisons
-    // TODO: Add insert() and erase() methods for arbitrary position modifications
     // TODO: Add bounds checking for operator[] in debug builds (at() method)
     // TODO: Add exception safety guarantees and proper RAII
-    // TODO: Consider adding small buffer optimization for tiny objects
-    // TODO: Add allocator template parameter for custom memory management
-    // TODO: Optimize growth factors based on empirical performance testing
     // TODO: Add noexcept specifications where appropriate for better optimization
 
+    // Customization point: a type is trivially relocatable when moving it to a
+    // new address and destroying the original is equivalent to a memcpy of its
+    // bytes. rotcev uses this to relocate whole buffers with memcpy/realloc.
+    // Specialize for your own types that hold no pointers into themselves.
+    template <typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    template <typename T, typename Deleter>
+    struct is_trivially_relocatable<std::unique_ptr<T, Deleter>> : is_trivially_relocatable<Deleter> {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
     template <typename T>
+    struct is_trivially_relocatable<std::vector<T, std::allocator<T>>> : std::true_type {};
+
+    template <typename First, typename Second>
+    struct is_trivially_relocatable<std::pair<First, Second>>
+        : std::bool_constant<is_trivially_relocatable_v<First> && is_trivially_relocatable_v<Second>> {};
+
+    template <typename T, size_t N>
+    struct is_trivially_relocatable<std::array<T, N>> : is_trivially_relocatable<T> {};
+
+#if defined(_LIBCPP_VERSION)
+    // libc++ strings keep no pointer into their own SSO buffer.
+    // libstdc++ strings do, so they stay on the move-construct path there.
+    template <typename CharT, typename Traits>
+    struct is_trivially_relocatable<std::basic_string<CharT, Traits, std::allocator<CharT>>> : std::true_type {};
+#endif
+
+    namespace detail
+    {
+        // True when Range exposes contiguous storage of T through std::data / std::size
+        template <typename Range, typename T, typename = void>
+        struct IsContiguousRangeOf : std::false_type {};
+
+        template <typename Range, typename T>
+        struct IsContiguousRangeOf<Range, T, std::void_t<
+            decltype(std::data(std::declval<Range &>())),
+            decltype(std::size(std::declval<Range &>()))>>
+            : std::is_same<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<Range &>()))>>, T> {};
+
+        // True when Alloc offers reallocate(Ptr, OldCount, NewCount), which rotcev
+        // prefers over allocate + memcpy + deallocate for trivially relocatable T
+        template <typename Alloc, typename T, typename = void>
+        struct HasReallocate : std::false_type {};
+
+        template <typename Alloc, typename T>
+        struct HasReallocate<Alloc, T, std::void_t<
+            decltype(std::declval<Alloc &>().reallocate(std::declval<T *>(), size_t(), size_t()))>> : std::true_type {};
+
+        // Relocation shared by rotcev and small_rotcev
+        // Move-constructs Count elements into uninitialized Dest and destroys the sources.
+        // Does not free the source buffer.
+        template <typename T, typename Alloc>
+        inline void RelocateElements(Alloc &Allocator, T *Dest, T *Source, size_t Count)
+        {
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                if (Count > 0)
+                {
+                    std::memcpy((void *)Dest, (void *)Source, sizeof(T) * Count);
+                }
+            }
+            else
+            {
+                using AllocTraits = std::allocator_traits<Alloc>;
+                for (size_t i = 0; i < Count; i++)
+                {
+                    AllocTraits::construct(Allocator, Dest + i, std::move(Source[i]));
+                    AllocTraits::destroy(Allocator, Source + i);
+                }
+            }
+        }
+    }
+
+    template <typename T, typename Alloc = malloc_allocator<T>, typename GrowthPolicy = default_growth>
     class rotcev
     {
     public:
         using ValueType = T;
-        using Iterator = RotcevIterator<rotcev<T>>;
+        using AllocatorType = Alloc;
+        using GrowthPolicyType = GrowthPolicy;
+        using Iterator = RotcevIterator<rotcev<T, Alloc, GrowthPolicy>>;
+        using ConstIterator = RotcevIterator<rotcev<T, Alloc, GrowthPolicy>, true>;
+        using ReverseIterator = std::reverse_iterator<Iterator>;
+        using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+        // Standard container names so std algorithms and adaptors (back_inserter, ...) work
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+        using reverse_iterator = ReverseIterator;
+        using const_reverse_iterator = ConstReverseIterator;
     private:
-        double get_growth_factor_factor()
+        using AllocTraits = std::allocator_traits<Alloc>;
+        using Stats = stats::detail::Hooks<T>;
+
+        size_t GrowCapacity(size_t MinimumCapacity)
+        {
+            return GrowthPolicy::template next_capacity<T>(m_Size, MinimumCapacity);
+        }
+
+        void MoveRessource(T *NewStart)
+        {
+            detail::RelocateElements(m_Allocator, NewStart, m_Start, m_Size);
+            AllocTraits::deallocate(m_Allocator, m_Start, m_Capacity);
+            Stats::Relocated(m_Size, !is_trivially_relocatable_v<T>);
+            Stats::Freed(m_Capacity);
+        }
+
+        // Moves the current elements into a buffer of exactly NewCapacity elements
+        void Reallocate(size_t NewCapacity)
+        {
+            if constexpr (CanReallocate)
+            {
+                if (m_Start && NewCapacity)
+                {
+                    // Compared as an integer, the old pointer is invalid once realloc moved the block
+                    std::uintptr_t OldAddress = reinterpret_cast<std::uintptr_t>(m_Start);
+                    m_Start = m_Allocator.reallocate(m_Start, m_Capacity, NewCapacity);
+                    Stats::Resized(m_Capacity, NewCapacity, m_Size, reinterpret_cast<std::uintptr_t>(m_Start) != OldAddress);
+                    m_Capacity = NewCapacity;
+                    return;
+                }
+            }
+
+            T *NewStart = NewCapacity ? AllocTraits::allocate(m_Allocator, NewCapacity) : nullptr;
+            if (NewStart)
+            {
+                Stats::Allocated(NewCapacity);
+            }
+            if (m_Start)
+            {
+                MoveRessource(NewStart);
+            }
+            m_Start = NewStart;
+            m_Capacity = NewCapacity;
+        }
+
+        template <typename... Args>
+        inline T &AllocateNewSpace(Args &&...Arguments)
+        {
+            if constexpr (CanReallocate)
+            {
+                if (m_Capacity < m_Size + 1)
+                {
+                    // Build the element first, the arguments may live inside the block realloc is about to move
+                    T Copy(std::forward<Args>(Arguments)...);
+                    Reallocate(GrowCapacity(m_Size + 1));
+                    AllocTraits::construct(m_Allocator, m_Start + m_Size, std::move(Copy));
+                    return m_Start[m_Size++];
+                }
+            }
+
+            if (m_Capacity < m_Size + 1)
+            {
+                size_t NewCapacity = GrowCapacity(m_Size + 1);
+                T *Start = AllocTraits::allocate(m_Allocator, NewCapacity);
+                Stats::Allocated(NewCapacity);
+
+                // Construct the new element first, the arguments may live inside the old buffer
+                AllocTraits::construct(m_Allocator, Start + m_Size, std::forward<Args>(Arguments)...);
+                if (m_Start)
+                {
+                    MoveRessource(Start);
+                }
+                m_Start = Start;
+                m_Capacity = NewCapacity;
+            }
+            else
+            {
+                AllocTraits::construct(m_Allocator, m_Start + m_Size, std::forward<Args>(Arguments)...);
+            }
+            return m_Start[m_Size++];
+        }
+
+        // Destroys the elements and hands the buffer back, leaving an empty container
+        void ReleaseBuffer() noexcept
         {
-            size_t size = sizeof(T);
-            return growth_factors[
-                (size <= 8) ? 0 
-               :(size <= 32) ? 1
-               :(size <= 128)  ? 2
-               :3];
+            if (m_Start)
+            {
+                DestroyRange(0, m_Size);
+                AllocTraits::deallocate(m_Allocator, m_Start, m_Capacity);
+                Stats::Released(m_Capacity, m_Size);
+                Stats::Freed(m_Capacity);
+            }
+            m_Start = nullptr;
+            m_Size = 0;
+            m_Capacity = 0;
         }
 
-        void MoveRessource(void *NewStart)
+        // Copies Count elements into the (empty) container's existing buffer,
+        // which must already hold at least Count elements
+        void CopyConstruct(const T *Source, size_t Count)
         {
-            if (IsTrivial)
+            if constexpr (IsTrivial)
             {
-                std::memcpy(NewStart, m_Start, (sizeof(T) * m_Size));
+                if (Count > 0)
+                {
+                    std::memcpy((void *)m_Start, (const void *)Source, sizeof(T) * Count);
+                }
+                m_Size = Count;
             }
             else
             {
-                for (size_t i = 0; i < m_Size; i++)
+                for (; m_Size < Count; m_Size++)
                 {
-                    new (((T *)NewStart) + i) T(std::move(m_Start[i]));
-                    m_Start[i].~T();
+                    AllocTraits::construct(m_Allocator, m_Start + m_Size, Source[m_Size]);
                 }
             }
-            free(m_Start);
         }
 
-        template <typename U>
-        inline void AllocateNewSpace(U &&Value)
+        void StealFrom(rotcev &Other) noexcept
         {
-            void *Start = 0x0;
-            bool needsReallocation = (m_Capacity < sizeof(T) * (m_Size + 1));
+            m_Start = Other.m_Start;
+            m_Size = Other.m_Size;
+            m_Capacity = Other.m_Capacity;
+            Other.m_Start = nullptr;
+            Other.m_Size = 0;
+            Other.m_Capacity = 0;
+        }
 
-            if (needsReallocation)
+        void DestroyRange(size_t From, size_t To) noexcept
+        {
+            if constexpr (!IsTrivial)
+            {
+                for (size_t i = From; i < To; i++)
+                {
+                    AllocTraits::destroy(m_Allocator, m_Start + i);
+                }
+            }
+        }
+
+        // Makes room for Count more elements with at most one relocation
+        void ReserveForAppend(size_t Count)
+        {
+            if (m_Capacity < m_Size + Count)
             {
-                size_t NewAllocationSize = static_cast<size_t>(m_Size * get_growth_factor_factor());
-                m_Capacity = sizeof(T) * std::max(NewAllocationSize, m_Size + 1);
-                Start = malloc(m_Capacity);
+                Reallocate(GrowCapacity(m_Size + Count));
+            }
+        }
 
-                if (m_Size > 0)
+        void AppendContiguous(const T *First, size_t Count)
+        {
+            if (PointsInside(First))
+            {
+                // Appending our own elements: growing moves them, find them again afterwards
+                size_t Offset = static_cast<size_t>(First - m_Start);
+                ReserveForAppend(Count);
+                First = m_Start + Offset;
+            }
+            else
+            {
+                ReserveForAppend(Count);
+            }
+            if constexpr (IsTrivial)
+            {
+                if (Count > 0)
                 {
-                    MoveRessource(Start);
+                    std::memcpy((void *)(m_Start + m_Size), (const void *)First, sizeof(T) * Count);
                 }
             }
             else
             {
-                Start = (void *)m_Start;
+                for (size_t i = 0; i < Count; i++)
+                {
+                    AllocTraits::construct(m_Allocator, m_Start + m_Size + i, First[i]);
+                }
+            }
+            m_Size += Count;
+        }
+
+        // Shifts [Index, m_Size) up by Count and leaves an uninitialized gap at Index.
+        // Only for trivially relocatable T; capacity must already be there.
+        void OpenGap(size_t Index, size_t Count) noexcept
+        {
+            if (Index < m_Size)
+            {
+                std::memmove((void *)(m_Start + Index + Count), (const void *)(m_Start + Index), sizeof(T) * (m_Size - Index));
+            }
+            m_Size += Count;
+        }
+
+        // Undoes OpenGap after constructing into the gap failed
+        void CloseGap(size_t Index, size_t Count) noexcept
+        {
+            m_Size -= Count;
+            if (Index < m_Size)
+            {
+                std::memmove((void *)(m_Start + Index), (const void *)(m_Start + Index + Count), sizeof(T) * (m_Size - Index));
+            }
+        }
+
+        // Fills a gap of Count elements at Index with copies produced by Make(i)
+        template <typename Maker>
+        void ConstructIntoGap(size_t Index, size_t Count, Maker &&Make)
+        {
+            size_t Built = 0;
+            try
+            {
+                for (; Built < Count; Built++)
+                {
+                    AllocTraits::construct(m_Allocator, m_Start + Index + Built, Make(Built));
+                }
             }
+            catch (...)
+            {
+                DestroyRange(Index, Index + Built);
+                CloseGap(Index, Count);
+                throw;
+            }
+        }
+
+        // Moves the elements appended after OldSize to Index (generic path for types
+        // that cannot be memmoved; still a single O(n) pass)
+        Iterator RotateAppended(size_t Index, size_t OldSize)
+        {
+            std::rotate(m_Start + Index, m_Start + OldSize, m_Start + m_Size);
+            return Iterator(m_Start + Index);
+        }
 
-            T *NewOBJ = ((T *)Start) + m_Size;
-            new (NewOBJ) T(std::forward<U>(Value));
-            m_Start = (T *)Start;
-            ++m_Size;
+        // Iterator types that can point at our own elements
+        template <typename It>
+        static constexpr bool IsOwnIterator = std::is_same_v<It, T *> || std::is_same_v<It, const T *> ||
+                                              std::is_same_v<It, Iterator> || std::is_same_v<It, ConstIterator>;
+
+        template <typename It>
+        bool PointsInside(It Position) const noexcept
+        {
+            if constexpr (std::is_same_v<It, T *> || std::is_same_v<It, const T *>)
+            {
+                return std::less_equal<const T *>()(m_Start, Position) && std::less<const T *>()(Position, m_Start + m_Size);
+            }
+            else if constexpr (std::is_same_v<It, Iterator> || std::is_same_v<It, ConstIterator>)
+            {
+                return PointsInside(Position.operator->());
+            }
+            else
+            {
+                return false;
+            }
         }
 
     public:
         rotcev()
         {}
+        explicit rotcev(const Alloc &Allocator)
+            : m_Allocator(Allocator)
+        {}
         ~rotcev()
         {
-            if (m_Start)
+            ReleaseBuffer();
+        }
+
+        // Allocates exactly other.size() elements; trivially copyable elements are copied with one memcpy
+        rotcev(const rotcev &other)
+            : m_Allocator(AllocTraits::select_on_container_copy_construction(other.m_Allocator))
+        {
+            if (other.m_Size > 0)
+            {
+                m_Start = AllocTraits::allocate(m_Allocator, other.m_Size);
+                m_Capacity = other.m_Size;
+                Stats::Allocated(m_Capacity);
+                CopyConstruct(other.m_Start, other.m_Size);
+            }
+        }
+
+        rotcev(rotcev &&other) noexcept
+            : m_Allocator(std::move(other.m_Allocator))
+        {
+            StealFrom(other);
+        }
+
+        rotcev &operator=(const rotcev &other)
+        {
+            if (this != &other)
             {
-                // Call destructors for non-trivial objects
-                if (!IsTrivial)
+                if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
                 {
-                    for (size_t i = 0; i < m_Size; i++)
+                    if (m_Allocator != other.m_Allocator)
+                    {
+                        ReleaseBuffer();
+                    }
+                    m_Allocator = other.m_Allocator;
+                }
+
+                clear();
+                if (m_Capacity < other.m_Size)
+                {
+                    ReleaseBuffer();
+                    m_Start = AllocTraits::allocate(m_Allocator, other.m_Size);
+                    m_Capacity = other.m_Size;
+                    Stats::Allocated(m_Capacity);
+                }
+                CopyConstruct(other.m_Start, other.m_Size);
+            }
+            return *this;
+        }
+
+        rotcev &operator=(rotcev &&other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+        {
+            if (this != &other)
+            {
+                if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+                {
+                    ReleaseBuffer();
+                    m_Allocator = std::move(other.m_Allocator);
+                    StealFrom(other);
+                }
+                else
+                {
+                    if (m_Allocator == other.m_Allocator)
+                    {
+                        ReleaseBuffer();
+                        StealFrom(other);
+                    }
+                    else
                     {
-                        m_Start[i].~T();
+                        // Different memory resources, fall back to moving element by element
+                        clear();
+                        reserve(other.m_Size);
+                        for (size_t i = 0; i < other.m_Size; i++)
+                        {
+                            AllocTraits::construct(m_Allocator, m_Start + i, std::move(other.m_Start[i]));
+                        }
+                        m_Size = other.m_Size;
+                        other.clear();
                     }
                 }
-                // Free the memory
-                free(m_Start);
             }
+            return *this;
         }
 
-        Iterator begin()
+        void swap(rotcev &other) noexcept
+        {
+            if constexpr (AllocTraits::propagate_on_container_swap::value)
+            {
+                std::swap(m_Allocator, other.m_Allocator);
+            }
+            std::swap(m_Start, other.m_Start);
+            std::swap(m_Size, other.m_Size);
+            std::swap(m_Capacity, other.m_Capacity);
+        }
+
+        Iterator begin() noexcept
         {
             return Iterator(m_Start);
         }
-        Iterator end()
+        Iterator end() noexcept
         {
             return Iterator(m_Start + m_Size);
         }
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(m_Start);
+        }
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator(m_Start + m_Size);
+        }
+        ConstIterator cbegin() const noexcept
+        {
+            return ConstIterator(m_Start);
+        }
+        ConstIterator cend() const noexcept
+        {
+            return ConstIterator(m_Start + m_Size);
+        }
+        ReverseIterator rbegin() noexcept
+        {
+            return ReverseIterator(end());
+        }
+        ReverseIterator rend() noexcept
+        {
+            return ReverseIterator(begin());
+        }
+        ConstReverseIterator rbegin() const noexcept
+        {
+            return ConstReverseIterator(end());
+        }
+        ConstReverseIterator rend() const noexcept
+        {
+            return ConstReverseIterator(begin());
+        }
+        ConstReverseIterator crbegin() const noexcept
+        {
+            return ConstReverseIterator(cend());
+        }
+        ConstReverseIterator crend() const noexcept
+        {
+            return ConstReverseIterator(cbegin());
+        }
+
         void push_back(const T &Value)
         {
             this->AllocateNewSpace(Value);
@@ -199,9 +747,21 @@ namespace blck
             this->AllocateNewSpace(std::move(Value));
         }
 
-        T &operator[](int S)
+        // Constructs the element in place from Arguments
+        template <typename... Args>
+        T &emplace_back(Args &&...Arguments)
         {
-            return *(m_Start + S);
+            return this->AllocateNewSpace(std::forward<Args>(Arguments)...);
+        }
+
+        T &operator[](size_t Index)
+        {
+            return *(m_Start + Index);
+        }
+
+        const T &operator[](size_t Index) const
+        {
+            return *(m_Start + Index);
         }
 
         inline size_t Size()
@@ -209,34 +769,458 @@ namespace blck
             return m_Size;
         }
 
-        rotcev(const rotcev &other) noexcept
+        inline size_t size() const noexcept
+        {
+            return m_Size;
+        }
+
+        inline size_t capacity() const noexcept
+        {
+            return m_Capacity;
+        }
+
+        // Most elements the allocator could hand out in one block
+        inline size_t max_size() const noexcept
+        {
+            return AllocTraits::max_size(m_Allocator);
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+        inline T *data() noexcept
+        {
+            return m_Start;
+        }
+
+        inline const T *data() const noexcept
+        {
+            return m_Start;
+        }
+
+        // Pre-allocates room for NewCapacity elements, never shrinks
+        void reserve(size_t NewCapacity)
+        {
+            if (NewCapacity > m_Capacity)
+            {
+                Reallocate(NewCapacity);
+            }
+        }
+
+        // Drops unused capacity, relocating the elements into an exactly sized buffer
+        void shrink_to_fit()
+        {
+            if (m_Capacity > m_Size)
+            {
+                Reallocate(m_Size);
+            }
+        }
+
+        void resize(size_t NewSize)
+        {
+            if (NewSize > m_Size)
+            {
+                reserve(NewSize);
+                for (size_t i = m_Size; i < NewSize; i++)
+                {
+                    AllocTraits::construct(m_Allocator, m_Start + i);
+                }
+            }
+            else
+            {
+                DestroyRange(NewSize, m_Size);
+            }
+            m_Size = NewSize;
+        }
+
+        void resize(size_t NewSize, const T &Value)
+        {
+            if (NewSize > m_Size)
+            {
+                reserve(NewSize);
+                for (size_t i = m_Size; i < NewSize; i++)
+                {
+                    AllocTraits::construct(m_Allocator, m_Start + i, Value);
+                }
+            }
+            else
+            {
+                DestroyRange(NewSize, m_Size);
+            }
+            m_Size = NewSize;
+        }
+
+        // Like resize(), but leaves new elements of trivial types uninitialized.
+        // Meant for callers that overwrite the whole range right away (e.g. read() into data()).
+        void resize_for_overwrite(size_t NewSize)
+        {
+            if constexpr (IsTrivial && std::is_trivially_default_constructible_v<T>)
+            {
+                reserve(NewSize);
+                m_Size = NewSize;
+            }
+            else
+            {
+                resize(NewSize);
+            }
+        }
+
+        // Appends [First, Last) with a single reallocation; pointer ranges of
+        // trivially copyable T are copied with one memcpy
+        template <typename InputIt>
+        void append(InputIt First, InputIt Last)
+        {
+            using Category = typename std::iterator_traits<InputIt>::iterator_category;
+            using Source = std::remove_cv_t<std::remove_pointer_t<InputIt>>;
+
+            if constexpr (std::is_pointer_v<InputIt> && std::is_same_v<Source, T>)
+            {
+                AppendContiguous(First, static_cast<size_t>(Last - First));
+            }
+            else if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+            {
+                size_t Count = static_cast<size_t>(std::distance(First, Last));
+                if constexpr (IsOwnIterator<InputIt>)
+                {
+                    if (PointsInside(First))
+                    {
+                        // A range of our own elements, copied by position so growing cannot strand it
+                        AppendContiguous(std::addressof(*First), Count);
+                        return;
+                    }
+                }
+                ReserveForAppend(Count);
+                for (; First != Last; ++First)
+                {
+                    AllocTraits::construct(m_Allocator, m_Start + m_Size, *First);
+                    ++m_Size;
+                }
+            }
+            else
+            {
+                for (; First != Last; ++First)
+                {
+                    push_back(*First);
+                }
+            }
+        }
+
+        template <typename Range>
+        void append_range(const Range &Source)
+        {
+            if constexpr (detail::IsContiguousRangeOf<const Range, T>::value)
+            {
+                AppendContiguous(std::data(Source), std::size(Source));
+            }
+            else
+            {
+                append(std::begin(Source), std::end(Source));
+            }
+        }
+
+        // Inserts before Position and returns an iterator to the new element.
+        // Trivially relocatable T shifts the tail with one memmove.
+        template <typename... Args>
+        Iterator emplace(ConstIterator Position, Args &&...Arguments)
+        {
+            size_t Index = static_cast<size_t>(Position - cbegin());
+            if (Index == m_Size)
+            {
+                emplace_back(std::forward<Args>(Arguments)...);
+                return Iterator(m_Start + Index);
+            }
+            // Build the element first, the arguments may live in the part about to shift
+            T Copy(std::forward<Args>(Arguments)...);
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                ReserveForAppend(1);
+                OpenGap(Index, 1);
+                AllocTraits::construct(m_Allocator, m_Start + Index, std::move(Copy));
+            }
+            else
+            {
+                ReserveForAppend(1);
+                AllocTraits::construct(m_Allocator, m_Start + m_Size, std::move(m_Start[m_Size - 1]));
+                ++m_Size;
+                std::move_backward(m_Start + Index, m_Start + m_Size - 2, m_Start + m_Size - 1);
+                m_Start[Index] = std::move(Copy);
+            }
+            return Iterator(m_Start + Index);
+        }
+
+        Iterator insert(ConstIterator Position, const T &Value)
+        {
+            return emplace(Position, Value);
+        }
+
+        Iterator insert(ConstIterator Position, T &&Value)
+        {
+            return emplace(Position, std::move(Value));
+        }
+
+        // Inserts Count copies of Value before Position
+        Iterator insert(ConstIterator Position, size_t Count, const T &Value)
+        {
+            size_t Index = static_cast<size_t>(Position - cbegin());
+            if (Count == 0)
+            {
+                return Iterator(m_Start + Index);
+            }
+            T Copy(Value);
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                ReserveForAppend(Count);
+                OpenGap(Index, Count);
+                ConstructIntoGap(Index, Count, [&Copy](size_t) -> const T & { return Copy; });
+                return Iterator(m_Start + Index);
+            }
+            else
+            {
+                size_t OldSize = m_Size;
+                ReserveForAppend(Count);
+                for (size_t i = 0; i < Count; i++, m_Size++)
+                {
+                    AllocTraits::construct(m_Allocator, m_Start + m_Size, Copy);
+                }
+                return RotateAppended(Index, OldSize);
+            }
+        }
+
+        // Inserts [First, Last) before Position. Forward ranges of trivially relocatable T
+        // open the gap with one memmove; other inputs are appended and rotated into place.
+        template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        Iterator insert(ConstIterator Position, InputIt First, InputIt Last)
+        {
+            using Category = typename std::iterator_traits<InputIt>::iterator_category;
+            size_t Index = static_cast<size_t>(Position - cbegin());
+
+            if (PointsInside(First))
+            {
+                // The source would move under us, take a copy first
+                rotcev Copy(m_Allocator);
+                Copy.append(First, Last);
+                return insert(Position, std::make_move_iterator(Copy.begin()), std::make_move_iterator(Copy.end()));
+            }
+
+            if constexpr (is_trivially_relocatable_v<T> && std::is_base_of_v<std::forward_iterator_tag, Category>)
+            {
+                size_t Count = static_cast<size_t>(std::distance(First, Last));
+                if (Count == 0)
+                {
+                    return Iterator(m_Start + Index);
+                }
+                ReserveForAppend(Count);
+                OpenGap(Index, Count);
+                if constexpr (std::is_pointer_v<InputIt> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T> && IsTrivial)
+                {
+                    std::memcpy((void *)(m_Start + Index), (const void *)First, sizeof(T) * Count);
+                }
+                else
+                {
+                    ConstructIntoGap(Index, Count, [&First](size_t) -> decltype(auto) { return *First++; });
+                }
+                return Iterator(m_Start + Index);
+            }
+            else
+            {
+                size_t OldSize = m_Size;
+                append(First, Last);
+                return RotateAppended(Index, OldSize);
+            }
+        }
+
+        Iterator insert(ConstIterator Position, std::initializer_list<T> Values)
+        {
+            return insert(Position, Values.begin(), Values.end());
+        }
+
+        // Removes [First, Last) and returns an iterator to the element after them.
+        // Trivially relocatable T closes the gap with one memmove.
+        Iterator erase(ConstIterator First, ConstIterator Last)
+        {
+            size_t Index = static_cast<size_t>(First - cbegin());
+            size_t Count = static_cast<size_t>(Last - First);
+            if (Count == 0)
+            {
+                return Iterator(m_Start + Index);
+            }
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                DestroyRange(Index, Index + Count);
+                CloseGap(Index, Count);
+            }
+            else
+            {
+                std::move(m_Start + Index + Count, m_Start + m_Size, m_Start + Index);
+                DestroyRange(m_Size - Count, m_Size);
+                m_Size -= Count;
+            }
+            return Iterator(m_Start + Index);
+        }
+
+        Iterator erase(ConstIterator Position)
+        {
+            return erase(Position, Position + 1);
+        }
+
+        // O(1) removal that does not keep the order: the last element takes the erased slot
+        Iterator unordered_erase(ConstIterator Position)
         {
-            for (size_t i = 0; i < other.m_Size; i++)
+            size_t Index = static_cast<size_t>(Position - cbegin());
+            size_t Last = m_Size - 1;
+            if (Index != Last)
             {
-                this->push_back(*(other.m_Start + i));
+                if constexpr (is_trivially_relocatable_v<T>)
+                {
+                    AllocTraits::destroy(m_Allocator, m_Start + Index);
+                    std::memcpy((void *)(m_Start + Index), (const void *)(m_Start + Last), sizeof(T));
+                    --m_Size;
+                    return Iterator(m_Start + Index);
+                }
+                else
+                {
+                    m_Start[Index] = std::move(m_Start[Last]);
+                }
             }
+            pop_back();
+            return Iterator(m_Start + Index);
+        }
+
+        // Removes every element matching Predicate in one pass and returns how many went.
+        // Trivially copyable T compacts with a branchless copy loop; other trivially
+        // relocatable T move each run of kept elements with a single memmove.
+        template <typename Predicate>
+        size_t erase_if(Predicate Pred)
+        {
+            size_t OldSize = m_Size;
+            if constexpr (IsTrivial)
+            {
+                // Branchless: every element is copied down, the write cursor only advances
+                // for kept ones. No per-run memmove calls, which lose on short runs.
+                size_t Write = 0;
+                size_t Read = 0;
+                try
+                {
+                    for (; Read < m_Size; Read++)
+                    {
+                        T Value = m_Start[Read];
+                        m_Start[Write] = Value;
+                        Write += !Pred(Value);
+                    }
+                }
+                catch (...)
+                {
+                    // [Read] is still intact, keep it and the rest
+                    std::memmove((void *)(m_Start + Write), (const void *)(m_Start + Read), sizeof(T) * (m_Size - Read));
+                    m_Size = Write + (m_Size - Read);
+                    throw;
+                }
+                m_Size = Write;
+            }
+            else if constexpr (is_trivially_relocatable_v<T>)
+            {
+                size_t Write = 0;
+                size_t Read = 0;
+                // Nothing moves until the first removed element
+                while (Read < m_Size && !Pred(m_Start[Read]))
+                {
+                    ++Read;
+                }
+                Write = Read;
+                size_t RunStart = Read;
+                try
+                {
+                    while (Read < m_Size)
+                    {
+                        // [Read] matched: drop it, then move the run of kept elements after it
+                        AllocTraits::destroy(m_Allocator, m_Start + Read);
+                        RunStart = ++Read;
+                        while (Read < m_Size && !Pred(m_Start[Read]))
+                        {
+                            ++Read;
+                        }
+                        size_t RunLength = Read - RunStart;
+                        if (RunLength > 0)
+                        {
+                            std::memmove((void *)(m_Start + Write), (const void *)(m_Start + RunStart), sizeof(T) * RunLength);
+                            Write += RunLength;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    // Pred threw on [Read]: keep the pending run and the rest, close the hole
+                    size_t Tail = m_Size - RunStart;
+                    std::memmove((void *)(m_Start + Write), (const void *)(m_Start + RunStart), sizeof(T) * Tail);
+                    m_Size = Write + Tail;
+                    throw;
+                }
+                m_Size = Write;
+            }
+            else
+            {
+                T *NewEnd = std::remove_if(m_Start, m_Start + m_Size, Pred);
+                size_t NewSize = static_cast<size_t>(NewEnd - m_Start);
+                DestroyRange(NewSize, m_Size);
+                m_Size = NewSize;
+            }
+            return OldSize - m_Size;
+        }
+
+        Alloc get_allocator() const noexcept
+        {
+            return m_Allocator;
         }
 
         inline void pop_back() noexcept
         {
             if (m_Size > 0)
             {
-                m_Start[m_Size - 1].~T();
+                AllocTraits::destroy(m_Allocator, m_Start + m_Size - 1);
                 --m_Size;
             }
         }
 
+        // Destroys all elements, keeps the allocated memory
+        void clear() noexcept
+        {
+            DestroyRange(0, m_Size);
+            m_Size = 0;
+        }
+
     private:
         T *m_Start = nullptr;
         size_t m_Size = 0;
-        size_t m_Capacity = 0;
+        size_t m_Capacity = 0; // in elements, not bytes
+        [[no_unique_address]] Alloc m_Allocator;
         static constexpr bool IsTrivial = std::is_trivially_copyable_v<T>;
-        static constexpr std::array<double, 4> growth_factors = {
-            10.0, // tiny objects (1-8 bytes)
-            5.0,  // small objects (9-32 bytes)
-            2.0,  // medium objects (33-128 bytes)
-            1.5   // large objects (129+ bytes)
-        };
+        static constexpr bool CanReallocate = is_trivially_relocatable_v<T> && detail::HasReallocate<Alloc, T>::value;
     };
 
+    template <typename T, typename Alloc, typename GrowthPolicy>
+    inline void swap(rotcev<T, Alloc, GrowthPolicy> &Lhs, rotcev<T, Alloc, GrowthPolicy> &Rhs) noexcept
+    {
+        Lhs.swap(Rhs);
+    }
+
+    // std::erase_if / std::erase counterparts (C++20 uniform container erasure)
+    template <typename T, typename Alloc, typename GrowthPolicy, typename Predicate>
+    inline size_t erase_if(rotcev<T, Alloc, GrowthPolicy> &Container, Predicate Pred)
+    {
+        return Container.erase_if(Pred);
+    }
+
+    template <typename T, typename Alloc, typename GrowthPolicy, typename U>
+    inline size_t erase(rotcev<T, Alloc, GrowthPolicy> &Container, const U &Value)
+    {
+        // Copy, Value may be one of the elements being removed
+        return Container.erase_if([Match = U(Value)](const T &Element) { return Element == Match; });
+    }
+
+    // rotcev only points at its heap buffer, so it relocates bitwise as long as its allocator does
+    template <typename T, typename Alloc, typename GrowthPolicy>
+    struct is_trivially_relocatable<rotcev<T, Alloc, GrowthPolicy>> : is_trivially_relocatable<Alloc> {};
+
 } // namespace blcke
\ No newline at end of file
@@ -0,0 +1,293 @@
+#pragma once
+#include "rotcev.hpp"
+#include "segment_layout.hpp"
+#include <atomic>
+#include <cstdlib>
+
+namespace blck
+{
+    // Append-only container for many concurrent producers.
+    // Elements live in power-of-two segments that are allocated on demand and
+    // never move, so a reference stays valid for the lifetime of the container.
+    // push_back makes sure the segment for the next free slot exists, claims the
+    // slot with a compare-and-swap, constructs the element in place and marks
+    // the slot ready; it never waits for other producers.
+    // size() is the longest prefix of ready slots. Whichever producer finishes
+    // advances it past every ready slot, so a stalled producer only holds back
+    // size(), not the other appends. Indices below size() may be read with
+    // operator[] from any thread while others keep appending.
+    // If allocating a segment throws, nothing has been claimed yet and the
+    // container is unchanged. Constructors must not throw: a claimed slot
+    // cannot be handed back without leaving a permanent gap in front of
+    // size(), so a throwing constructor ends the program.
+    // clear() and destruction must not race with other calls.
+    // Alloc is called from several threads and has to be thread-safe
+    // (malloc_allocator and std::allocator are, arena_allocator is not).
+    template <typename T, typename Alloc = malloc_allocator<T>, size_t FirstSegmentSize = 32>
+    class rotcev_concurrent
+    {
+    public:
+        using ValueType = T;
+        using AllocatorType = Alloc;
+    private:
+        using AllocTraits = std::allocator_traits<Alloc>;
+        using Layout = detail::SegmentLayout<FirstSegmentSize>;
+        using ReadyFlag = std::atomic<unsigned char>;
+
+        // Returns the element storage of Segment, allocating it if no other thread did yet
+        T *EnsureSegment(size_t Segment)
+        {
+            T *Existing = m_Segments[Segment].load(std::memory_order_acquire);
+            if (Existing)
+            {
+                return Existing;
+            }
+            T *Fresh = AllocTraits::allocate(m_Allocator, Layout::SegmentCapacity(Segment));
+            if (m_Segments[Segment].compare_exchange_strong(Existing, Fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return Fresh;
+            }
+            AllocTraits::deallocate(m_Allocator, Fresh, Layout::SegmentCapacity(Segment));
+            return Existing;
+        }
+
+        // Same for the zero-initialized ready flags of Segment
+        ReadyFlag *EnsureFlags(size_t Segment)
+        {
+            ReadyFlag *Existing = m_Ready[Segment].load(std::memory_order_acquire);
+            if (Existing)
+            {
+                return Existing;
+            }
+            ReadyFlag *Fresh = static_cast<ReadyFlag *>(calloc(Layout::SegmentCapacity(Segment), sizeof(ReadyFlag)));
+            if (!Fresh)
+            {
+                throw std::bad_alloc();
+            }
+            if (m_Ready[Segment].compare_exchange_strong(Existing, Fresh, std::memory_order_seq_cst))
+            {
+                return Fresh;
+            }
+            free(Fresh);
+            return Existing;
+        }
+
+        // Claims Count consecutive slots, allocating their segments and flags first
+        // so an allocation failure throws before any slot is taken
+        size_t Claim(size_t Count)
+        {
+            size_t Begin = m_Claimed.load(std::memory_order_seq_cst);
+            do
+            {
+                for (size_t Segment = Layout::SegmentOf(Begin); Layout::SegmentBase(Segment) < Begin + Count; Segment++)
+                {
+                    EnsureFlags(Segment);
+                    EnsureSegment(Segment);
+                }
+            } while (!m_Claimed.compare_exchange_weak(Begin, Begin + Count, std::memory_order_seq_cst));
+            return Begin;
+        }
+
+        ReadyFlag &FlagFor(size_t Index) noexcept
+        {
+            size_t Segment = Layout::SegmentOf(Index);
+            return m_Ready[Segment].load(std::memory_order_seq_cst)[Index - Layout::SegmentBase(Segment)];
+        }
+
+        // Only called for claimed slots, their flags exist
+        bool IsReady(size_t Index) noexcept
+        {
+            return FlagFor(Index).load(std::memory_order_seq_cst) != 0;
+        }
+
+        // See the class comment, a throwing constructor ends the program
+        template <typename... Args>
+        void ConstructAt(T *Slot, Args &&...Arguments) noexcept
+        {
+            AllocTraits::construct(m_Allocator, Slot, std::forward<Args>(Arguments)...);
+        }
+
+        // Marks [Begin, End) ready and moves size() forward over every ready slot.
+        // Flags and the published count are sequentially consistent so that of two
+        // producers finishing neighbouring slots at least one sees the other's flag.
+        void MarkReady(size_t Begin, size_t End) noexcept
+        {
+            for (size_t i = Begin; i < End; i++)
+            {
+                FlagFor(i).store(1, std::memory_order_seq_cst);
+            }
+            size_t Published = m_Published.load(std::memory_order_seq_cst);
+            while (Published < m_Claimed.load(std::memory_order_seq_cst) && IsReady(Published))
+            {
+                if (m_Published.compare_exchange_weak(Published, Published + 1, std::memory_order_seq_cst))
+                {
+                    ++Published;
+                }
+            }
+        }
+
+        void DestroyAll() noexcept
+        {
+            size_t Count = m_Published.load(std::memory_order_relaxed);
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (size_t i = 0; i < Count; i++)
+                {
+                    AllocTraits::destroy(m_Allocator, &(*this)[i]);
+                }
+            }
+        }
+
+    public:
+        rotcev_concurrent()
+        {}
+        explicit rotcev_concurrent(const Alloc &Allocator)
+            : m_Allocator(Allocator)
+        {}
+        ~rotcev_concurrent()
+        {
+            DestroyAll();
+            for (size_t Segment = 0; Segment < Layout::MaxSegments; Segment++)
+            {
+                T *Data = m_Segments[Segment].load(std::memory_order_relaxed);
+                if (Data)
+                {
+                    AllocTraits::deallocate(m_Allocator, Data, Layout::SegmentCapacity(Segment));
+                }
+                free(m_Ready[Segment].load(std::memory_order_relaxed));
+            }
+        }
+
+        rotcev_concurrent(const rotcev_concurrent &) = delete;
+        rotcev_concurrent &operator=(const rotcev_concurrent &) = delete;
+
+        // Thread-safe. Returns the index of the new element.
+        template <typename... Args>
+        size_t emplace_back(Args &&...Arguments)
+        {
+            size_t Index = Claim(1);
+            ConstructAt(&(*this)[Index], std::forward<Args>(Arguments)...);
+            MarkReady(Index, Index + 1);
+            return Index;
+        }
+
+        size_t push_back(const T &Value)
+        {
+            return emplace_back(Value);
+        }
+
+        size_t push_back(T &&Value)
+        {
+            return emplace_back(std::move(Value));
+        }
+
+        // Thread-safe. Claims Count consecutive slots at once and copies [First, First + Count)
+        // into them; cheaper than Count separate push_backs. Returns the index of the first one.
+        template <typename InputIt>
+        size_t append(InputIt First, size_t Count)
+        {
+            size_t Begin = Claim(Count);
+            for (size_t i = 0; i < Count; i++, ++First)
+            {
+                ConstructAt(&(*this)[Begin + i], *First);
+            }
+            MarkReady(Begin, Begin + Count);
+            return Begin;
+        }
+
+        // Number of published elements, every index below it is safe to read
+        inline size_t size() const noexcept
+        {
+            return m_Published.load(std::memory_order_acquire);
+        }
+
+        inline bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        // Elements that fit in the segments allocated so far
+        size_t capacity() const noexcept
+        {
+            size_t Segments = 0;
+            while (Segments < Layout::MaxSegments && m_Segments[Segments].load(std::memory_order_acquire))
+            {
+                Segments++;
+            }
+            return Layout::CapacityOf(Segments);
+        }
+
+        // Index has to be below a size() this thread has observed
+        T &operator[](size_t Index) noexcept
+        {
+            size_t Segment = Layout::SegmentOf(Index);
+            return m_Segments[Segment].load(std::memory_order_acquire)[Index - Layout::SegmentBase(Segment)];
+        }
+
+        const T &operator[](size_t Index) const noexcept
+        {
+            size_t Segment = Layout::SegmentOf(Index);
+            return m_Segments[Segment].load(std::memory_order_acquire)[Index - Layout::SegmentBase(Segment)];
+        }
+
+        // Visits the published prefix one contiguous segment at a time
+        template <typename F>
+        void for_each(F Function) const
+        {
+            size_t Count = size();
+            for (size_t Segment = 0; Layout::SegmentBase(Segment) < Count; Segment++)
+            {
+                const T *Data = m_Segments[Segment].load(std::memory_order_acquire);
+                size_t Base = Layout::SegmentBase(Segment);
+                size_t End = (Count - Base < Layout::SegmentCapacity(Segment)) ? Count - Base : Layout::SegmentCapacity(Segment);
+                for (size_t i = 0; i < End; i++)
+                {
+                    Function(Data[i]);
+                }
+            }
+        }
+
+        // Allocates the segments for NewCapacity elements up front so producers never allocate.
+        // Thread-safe.
+        void reserve(size_t NewCapacity)
+        {
+            for (size_t Segment = 0; Layout::SegmentBase(Segment) < NewCapacity; Segment++)
+            {
+                EnsureFlags(Segment);
+                EnsureSegment(Segment);
+            }
+        }
+
+        // Destroys every element but keeps the segments. Not thread-safe.
+        void clear() noexcept
+        {
+            DestroyAll();
+            size_t Count = m_Claimed.load(std::memory_order_relaxed);
+            for (size_t Segment = 0; Layout::SegmentBase(Segment) < Count; Segment++)
+            {
+                ReadyFlag *Flags = m_Ready[Segment].load(std::memory_order_relaxed);
+                for (size_t i = 0; i < Layout::SegmentCapacity(Segment); i++)
+                {
+                    Flags[i].store(0, std::memory_order_relaxed);
+                }
+            }
+            m_Claimed.store(0, std::memory_order_relaxed);
+            m_Published.store(0, std::memory_order_release);
+        }
+
+        Alloc get_allocator() const noexcept
+        {
+            return m_Allocator;
+        }
+
+    private:
+        std::atomic<T *> m_Segments[Layout::MaxSegments] = {};
+        std::atomic<ReadyFlag *> m_Ready[Layout::MaxSegments] = {};
+        // Claims and publication are hammered by different phases of an append,
+        // keep them on separate cache lines
+        alignas(64) std::atomic<size_t> m_Claimed{0};
+        alignas(64) std::atomic<size_t> m_Published{0};
+        [[no_unique_address]] Alloc m_Allocator;
+    };
+
+} // namespace blck
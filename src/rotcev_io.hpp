@@ -0,0 +1,370 @@
+#pragma once
+#include "rotcev.hpp"
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace blck
+{
+    // Versioned binary format for rotcev.
+    //
+    // A stream starts with a 24 byte header (magic, version, byte order mark,
+    // nesting depth, size of the innermost element, element count) followed by
+    // the payload. A rotcev of trivially copyable T is written as its raw bytes
+    // with one write(); a rotcev<rotcev<...>> writes every inner container as a
+    // 64 bit length followed by that container's payload, recursively.
+    // Files written on a machine with the other byte order are swapped on read
+    // when the innermost type is arithmetic and rejected otherwise.
+    // Format errors and stream failures are thrown as std::runtime_error; so
+    // are element counts beyond max_size() or, on a seekable stream, beyond
+    // what is left of it.
+    namespace detail
+    {
+        // Depth 0 is a trivially copyable leaf, every rotcev level adds one
+        template <typename T>
+        struct BinaryTraits
+        {
+            static constexpr bool Supported = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>;
+            static constexpr uint16_t Depth = 0;
+            using Scalar = T;
+        };
+
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        struct BinaryTraits<rotcev<T, Alloc, GrowthPolicy>>
+        {
+            static constexpr bool Supported = BinaryTraits<T>::Supported;
+            static constexpr uint16_t Depth = BinaryTraits<T>::Depth + 1;
+            using Scalar = typename BinaryTraits<T>::Scalar;
+        };
+
+        struct BinaryHeader
+        {
+            char m_Magic[8];
+            uint16_t m_Version;
+            uint16_t m_ByteOrder;
+            uint16_t m_Depth;
+            uint16_t m_ScalarSize;
+            uint64_t m_Count;
+        };
+        static_assert(sizeof(BinaryHeader) == 24, "BinaryHeader is part of the file format");
+
+        inline constexpr char BinaryMagic[8] = {'R', 'O', 'T', 'C', 'E', 'V', 'B', 'N'};
+        inline constexpr uint16_t BinaryVersion = 1;
+        // Reads back as 0x0201 on a machine with the other byte order
+        inline constexpr uint16_t BinaryByteOrder = 0x0102;
+
+        [[noreturn]] inline void BinaryFail(const char *What)
+        {
+            throw std::runtime_error(std::string("rotcev_io: ") + What);
+        }
+
+        inline void WriteBytes(std::ostream &Out, const void *Source, size_t Bytes)
+        {
+            if (Bytes > 0 && !Out.write(static_cast<const char *>(Source), static_cast<std::streamsize>(Bytes)))
+            {
+                BinaryFail("write failed");
+            }
+        }
+
+        inline void ReadBytes(std::istream &In, void *Dest, size_t Bytes)
+        {
+            if (Bytes > 0 && !In.read(static_cast<char *>(Dest), static_cast<std::streamsize>(Bytes)))
+            {
+                BinaryFail("unexpected end of stream");
+            }
+        }
+
+        // Bytes left in a seekable stream, UINT64_MAX when it cannot tell
+        inline uint64_t RemainingBytes(std::istream &In)
+        {
+            std::istream::pos_type Here = In.tellg();
+            if (Here == std::istream::pos_type(-1))
+            {
+                return UINT64_MAX;
+            }
+            In.seekg(0, std::ios::end);
+            std::istream::pos_type End = In.tellg();
+            if (!In || End == std::istream::pos_type(-1))
+            {
+                In.clear();
+                In.seekg(Here);
+                return UINT64_MAX;
+            }
+            In.seekg(Here);
+            return End > Here ? static_cast<uint64_t>(End - Here) : 0;
+        }
+
+        // Counts come from the stream: a corrupt one must fail here instead of
+        // turning into a huge (or, multiplied out, a wrapped tiny) allocation
+        inline void CheckPayload(std::istream &In, uint64_t Count, size_t MinimumBytes)
+        {
+            if (Count > UINT64_MAX / MinimumBytes || Count * MinimumBytes > RemainingBytes(In))
+            {
+                BinaryFail("element count exceeds the stream payload");
+            }
+        }
+
+        inline size_t PayloadBytes(uint64_t Count, size_t ElementSize)
+        {
+            if (Count > SIZE_MAX / ElementSize)
+            {
+                BinaryFail("element count overflows the address space");
+            }
+            return static_cast<size_t>(Count) * ElementSize;
+        }
+
+        // Reads at least this large are checked against the stream before allocating
+        inline constexpr size_t CheckedReadBytes = size_t(64) << 10;
+
+        template <typename T>
+        inline void ByteSwap(T *Values, size_t Count) noexcept
+        {
+            for (size_t i = 0; i < Count; i++)
+            {
+                unsigned char *Bytes = reinterpret_cast<unsigned char *>(Values + i);
+                for (size_t Low = 0, High = sizeof(T) - 1; Low < High; Low++, High--)
+                {
+                    unsigned char Byte = Bytes[Low];
+                    Bytes[Low] = Bytes[High];
+                    Bytes[High] = Byte;
+                }
+            }
+        }
+
+        inline uint64_t ReadLength(std::istream &In, bool Swap)
+        {
+            uint64_t Length = 0;
+            ReadBytes(In, &Length, sizeof(Length));
+            if (Swap)
+            {
+                ByteSwap(&Length, 1);
+            }
+            return Length;
+        }
+
+        template <typename T>
+        void WriteElements(std::ostream &Out, const T *Source, size_t Count)
+        {
+            if constexpr (BinaryTraits<T>::Depth == 0)
+            {
+                WriteBytes(Out, Source, Count * sizeof(T));
+            }
+            else
+            {
+                for (size_t i = 0; i < Count; i++)
+                {
+                    uint64_t Length = Source[i].size();
+                    WriteBytes(Out, &Length, sizeof(Length));
+                    WriteElements(Out, Source[i].data(), Source[i].size());
+                }
+            }
+        }
+
+        // Appends Count elements read from In to Dest
+        template <typename Container>
+        void ReadElements(std::istream &In, Container &Dest, uint64_t Count, bool Swap)
+        {
+            using T = typename Container::ValueType;
+            if (Count > Dest.max_size() - Dest.size())
+            {
+                BinaryFail("element count exceeds max_size()");
+            }
+            if constexpr (BinaryTraits<T>::Depth == 0)
+            {
+                size_t Bytes = PayloadBytes(Count, sizeof(T));
+                if (Bytes >= CheckedReadBytes)
+                {
+                    CheckPayload(In, Count, sizeof(T));
+                }
+                size_t Offset = Dest.size();
+                Dest.resize_for_overwrite(Offset + static_cast<size_t>(Count));
+                ReadBytes(In, Dest.data() + Offset, Bytes);
+                if (Swap)
+                {
+                    ByteSwap(Dest.data() + Offset, Count);
+                }
+            }
+            else
+            {
+                // Every inner container is at least its length field
+                if (PayloadBytes(Count, sizeof(uint64_t)) >= CheckedReadBytes)
+                {
+                    CheckPayload(In, Count, sizeof(uint64_t));
+                }
+                Dest.reserve(Dest.size() + static_cast<size_t>(Count));
+                for (size_t i = 0; i < Count; i++)
+                {
+                    T &Inner = Dest.emplace_back();
+                    ReadElements(In, Inner, ReadLength(In, Swap), Swap);
+                }
+            }
+        }
+
+        template <typename T>
+        void WriteHeader(std::ostream &Out, size_t Count)
+        {
+            BinaryHeader Header{};
+            std::memcpy(Header.m_Magic, BinaryMagic, sizeof(BinaryMagic));
+            Header.m_Version = BinaryVersion;
+            Header.m_ByteOrder = BinaryByteOrder;
+            Header.m_Depth = BinaryTraits<T>::Depth;
+            Header.m_ScalarSize = sizeof(typename BinaryTraits<T>::Scalar);
+            Header.m_Count = Count;
+            WriteBytes(Out, &Header, sizeof(Header));
+        }
+
+        // Validates the header against T, returns the element count and whether to byte swap
+        template <typename T>
+        uint64_t ReadHeader(std::istream &In, bool &Swap)
+        {
+            using Scalar = typename BinaryTraits<T>::Scalar;
+            BinaryHeader Header;
+            ReadBytes(In, &Header, sizeof(Header));
+            if (std::memcmp(Header.m_Magic, BinaryMagic, sizeof(BinaryMagic)) != 0)
+            {
+                BinaryFail("not a rotcev binary stream");
+            }
+            Swap = Header.m_ByteOrder != BinaryByteOrder;
+            if (Swap)
+            {
+                ByteSwap(&Header.m_Version, 1);
+                ByteSwap(&Header.m_ByteOrder, 1);
+                ByteSwap(&Header.m_Depth, 1);
+                ByteSwap(&Header.m_ScalarSize, 1);
+                ByteSwap(&Header.m_Count, 1);
+                if (Header.m_ByteOrder != BinaryByteOrder)
+                {
+                    BinaryFail("corrupt byte order mark");
+                }
+                if (!std::is_arithmetic_v<Scalar>)
+                {
+                    BinaryFail("stream was written with the other byte order and the element type cannot be swapped");
+                }
+            }
+            if (Header.m_Version != BinaryVersion)
+            {
+                BinaryFail("unsupported format version");
+            }
+            if (Header.m_Depth != BinaryTraits<T>::Depth)
+            {
+                BinaryFail("stream nesting depth does not match the container");
+            }
+            if (Header.m_ScalarSize != sizeof(Scalar))
+            {
+                BinaryFail("stream holds elements of a different size");
+            }
+            CheckPayload(In, Header.m_Count, BinaryTraits<T>::Depth == 0 ? sizeof(T) : sizeof(uint64_t));
+            return Header.m_Count;
+        }
+    }
+
+    template <typename T, typename Alloc, typename GrowthPolicy>
+    void write_binary(std::ostream &Out, const rotcev<T, Alloc, GrowthPolicy> &Source)
+    {
+        static_assert(detail::BinaryTraits<T>::Supported, "write_binary needs trivially copyable, non-pointer elements at the innermost level");
+        detail::WriteHeader<T>(Out, Source.size());
+        detail::WriteElements(Out, Source.data(), Source.size());
+    }
+
+    // Replaces the contents of Dest with the container stored in In
+    template <typename T, typename Alloc, typename GrowthPolicy>
+    void read_binary(std::istream &In, rotcev<T, Alloc, GrowthPolicy> &Dest)
+    {
+        static_assert(detail::BinaryTraits<T>::Supported, "read_binary needs trivially copyable, non-pointer elements at the innermost level");
+        bool Swap = false;
+        uint64_t Count = detail::ReadHeader<T>(In, Swap);
+        Dest.clear();
+        detail::ReadElements(In, Dest, Count, Swap);
+    }
+
+    template <typename T, typename Alloc, typename GrowthPolicy>
+    void save_binary(const std::string &Path, const rotcev<T, Alloc, GrowthPolicy> &Source)
+    {
+        std::ofstream Out(Path, std::ios::binary | std::ios::trunc);
+        if (!Out)
+        {
+            detail::BinaryFail(("cannot open " + Path).c_str());
+        }
+        write_binary(Out, Source);
+        if (!Out.flush())
+        {
+            detail::BinaryFail(("cannot flush " + Path).c_str());
+        }
+    }
+
+    template <typename T, typename Alloc, typename GrowthPolicy>
+    void load_binary(const std::string &Path, rotcev<T, Alloc, GrowthPolicy> &Dest)
+    {
+        std::ifstream In(Path, std::ios::binary);
+        if (!In)
+        {
+            detail::BinaryFail(("cannot open " + Path).c_str());
+        }
+        read_binary(In, Dest);
+    }
+
+    // Reads a stream written by write_binary a fixed number of top level
+    // elements at a time, so streams larger than memory can be processed with
+    // one chunk in flight. For nested containers a chunk is ChunkSize inner
+    // containers.
+    template <typename T, typename Alloc = malloc_allocator<T>, typename GrowthPolicy = default_growth>
+    class binary_chunk_reader
+    {
+        static_assert(detail::BinaryTraits<T>::Supported, "binary_chunk_reader needs trivially copyable, non-pointer elements at the innermost level");
+
+    public:
+        using ChunkType = rotcev<T, Alloc, GrowthPolicy>;
+
+        binary_chunk_reader(std::istream &In, size_t ChunkSize)
+            : m_In(In), m_ChunkSize(ChunkSize)
+        {
+            if (ChunkSize == 0)
+            {
+                throw std::logic_error("binary_chunk_reader: ChunkSize has to be at least one");
+            }
+            m_Remaining = detail::ReadHeader<T>(In, m_Swap);
+            m_Total = m_Remaining;
+        }
+
+        // Replaces Chunk with the next elements, returns false once the stream is exhausted.
+        // Reusing the same Chunk keeps its buffer, so steady state reads do not allocate.
+        bool next(ChunkType &Chunk)
+        {
+            Chunk.clear();
+            if (m_Remaining == 0)
+            {
+                return false;
+            }
+            size_t Count = m_Remaining < m_ChunkSize ? static_cast<size_t>(m_Remaining) : m_ChunkSize;
+            detail::ReadElements(m_In, Chunk, Count, m_Swap);
+            m_Remaining -= Count;
+            return true;
+        }
+
+        inline uint64_t total() const noexcept
+        {
+            return m_Total;
+        }
+
+        inline uint64_t remaining() const noexcept
+        {
+            return m_Remaining;
+        }
+
+        inline size_t chunk_size() const noexcept
+        {
+            return m_ChunkSize;
+        }
+
+    private:
+        std::istream &m_In;
+        size_t m_ChunkSize;
+        uint64_t m_Total = 0;
+        uint64_t m_Remaining = 0;
+        bool m_Swap = false;
+    };
+
+} // namespace blck
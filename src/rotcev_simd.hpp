@@ -0,0 +1,635 @@
+#pragma once
+#include "rotcev.hpp"
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Vectorized bulk kernels for rotcev of arithmetic types (int, float, double, ...).
+// Each kernel is written once with GCC vector extensions, compiled for SSE2,
+// AVX2 and AVX-512, and the widest instruction set the CPU supports is picked
+// at runtime. Everything else (and non-x86 targets) uses the scalar loop.
+// Floating point sums and dot products are accumulated lane-wise, so the
+// rounding can differ slightly from a left-to-right scalar loop.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ROTCEV_SIMD_X86 1
+#define ROTCEV_SIMD_INLINE __attribute__((always_inline)) inline
+#define ROTCEV_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define ROTCEV_SIMD_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl")))
+#else
+#define ROTCEV_SIMD_X86 0
+#define ROTCEV_SIMD_INLINE inline
+#endif
+
+namespace blck
+{
+    namespace simd
+    {
+        enum class isa
+        {
+            scalar,
+            sse2,
+            avx2,
+            avx512
+        };
+
+        inline const char *isa_name(isa Isa) noexcept
+        {
+            switch (Isa)
+            {
+            case isa::avx512: return "AVX-512";
+            case isa::avx2: return "AVX2";
+            case isa::sse2: return "SSE2";
+            default: return "scalar";
+            }
+        }
+
+        // Widest instruction set this CPU can run
+        inline isa detect_isa() noexcept
+        {
+#if ROTCEV_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+            {
+                return isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return isa::avx2;
+            }
+            return isa::sse2;
+#else
+            return isa::scalar;
+#endif
+        }
+
+        namespace detail
+        {
+            inline isa &ActiveIsa() noexcept
+            {
+                static isa Active = detect_isa();
+                return Active;
+            }
+        }
+
+        inline isa active_isa() noexcept
+        {
+            return detail::ActiveIsa();
+        }
+
+        // Forces a narrower instruction set (e.g. to benchmark the scalar path).
+        // Requests above what the CPU supports are clamped.
+        inline void set_isa(isa Isa) noexcept
+        {
+            isa Detected = detect_isa();
+            detail::ActiveIsa() = (static_cast<int>(Isa) > static_cast<int>(Detected)) ? Detected : Isa;
+        }
+
+        namespace detail
+        {
+            template <typename T, size_t Bytes>
+            struct VecOf
+            {
+                typedef T Type __attribute__((vector_size(Bytes)));
+            };
+
+            template <typename T, size_t Bytes>
+            using Vec = typename VecOf<T, Bytes>::Type;
+
+            // Loads and stores go through memcpy so unaligned buffers are fine.
+            // Vectors are passed by reference, returning them by value would
+            // trip GCC's ABI warning for the wider instruction sets.
+            template <typename V, typename T>
+            ROTCEV_SIMD_INLINE void Load(V &Value, const T *Ptr) noexcept
+            {
+                std::memcpy(&Value, Ptr, sizeof(V));
+            }
+
+            template <typename V, typename T>
+            ROTCEV_SIMD_INLINE void Store(T *Ptr, const V &Value) noexcept
+            {
+                std::memcpy(Ptr, &Value, sizeof(V));
+            }
+
+            // Arithmetic on integers runs on the unsigned type so that overflow
+            // wraps instead of being undefined; comparisons keep the real type
+            template <typename T, bool = std::is_integral_v<T>>
+            struct WrapOf
+            {
+                using Type = std::make_unsigned_t<T>;
+            };
+
+            template <typename T>
+            struct WrapOf<T, false>
+            {
+                using Type = T;
+            };
+
+            template <typename T>
+            using Wrap = typename WrapOf<T>::Type;
+
+            // Every kernel has Run<Bytes>, Bytes == 0 is the scalar loop
+
+            struct FillKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE void Run(T *Data, size_t Count, T Value)
+                {
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<T, Bytes>;
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        const V Broadcast = V{} + Value;
+                        const size_t VecEnd = Count - Count % Lanes;
+                        for (; i < VecEnd; i += Lanes)
+                        {
+                            Store(Data + i, Broadcast);
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        Data[i] = Value;
+                    }
+                }
+            };
+
+            struct IotaKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE void Run(T *Data, size_t Count, T Start)
+                {
+                    using W = Wrap<T>;
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<W, Bytes>;
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        V Current = V{} + static_cast<W>(Start);
+                        for (size_t l = 0; l < Lanes; l++)
+                        {
+                            Current[l] += static_cast<W>(l);
+                        }
+                        const V Step = V{} + static_cast<W>(Lanes);
+                        const size_t VecEnd = Count - Count % Lanes;
+                        for (; i < VecEnd; i += Lanes)
+                        {
+                            Store(Data + i, Current);
+                            Current += Step;
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        Data[i] = static_cast<T>(static_cast<W>(Start) + static_cast<W>(i));
+                    }
+                }
+            };
+
+            struct SumKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE T Run(const T *Data, size_t Count)
+                {
+                    using W = Wrap<T>;
+                    W Result{};
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<W, Bytes>;
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        V Acc0{}, Acc1{};
+                        const size_t PairEnd = Count - Count % (2 * Lanes);
+                        for (; i < PairEnd; i += 2 * Lanes)
+                        {
+                            V Block0, Block1;
+                            Load(Block0, Data + i);
+                            Load(Block1, Data + i + Lanes);
+                            Acc0 += Block0;
+                            Acc1 += Block1;
+                        }
+                        Acc0 += Acc1;
+                        for (size_t l = 0; l < Lanes; l++)
+                        {
+                            Result += Acc0[l];
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        Result += static_cast<W>(Data[i]);
+                    }
+                    return static_cast<T>(Result);
+                }
+            };
+
+            struct MinKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE T Run(const T *Data, size_t Count)
+                {
+                    T Result = Data[0];
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<T, Bytes>;
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        V Acc = V{} + Data[0];
+                        const size_t VecEnd = Count - Count % Lanes;
+                        for (; i < VecEnd; i += Lanes)
+                        {
+                            V Block;
+                            Load(Block, Data + i);
+                            Acc = (Block < Acc) ? Block : Acc;
+                        }
+                        for (size_t l = 0; l < Lanes; l++)
+                        {
+                            Result = (Acc[l] < Result) ? Acc[l] : Result;
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        Result = (Data[i] < Result) ? Data[i] : Result;
+                    }
+                    return Result;
+                }
+            };
+
+            struct MaxKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE T Run(const T *Data, size_t Count)
+                {
+                    T Result = Data[0];
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<T, Bytes>;
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        V Acc = V{} + Data[0];
+                        const size_t VecEnd = Count - Count % Lanes;
+                        for (; i < VecEnd; i += Lanes)
+                        {
+                            V Block;
+                            Load(Block, Data + i);
+                            Acc = (Block > Acc) ? Block : Acc;
+                        }
+                        for (size_t l = 0; l < Lanes; l++)
+                        {
+                            Result = (Acc[l] > Result) ? Acc[l] : Result;
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        Result = (Data[i] > Result) ? Data[i] : Result;
+                    }
+                    return Result;
+                }
+            };
+
+            struct FindKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE size_t Run(const T *Data, size_t Count, T Value)
+                {
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<T, Bytes>;
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        const V Needle = V{} + Value;
+                        const size_t VecEnd = Count - Count % Lanes;
+                        for (; i < VecEnd; i += Lanes)
+                        {
+                            V Block;
+                            Load(Block, Data + i);
+                            auto Mask = (Block == Needle);
+                            bool Hit = false;
+                            for (size_t l = 0; l < Lanes; l++)
+                            {
+                                Hit |= (Mask[l] != 0);
+                            }
+                            if (Hit)
+                            {
+                                break; // the scalar tail pins down the lane
+                            }
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        if (Data[i] == Value)
+                        {
+                            return i;
+                        }
+                    }
+                    return Count;
+                }
+            };
+
+            struct CountKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE size_t Run(const T *Data, size_t Count, T Value)
+                {
+                    size_t Result = 0;
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<T, Bytes>;
+                        using MaskV = decltype(V{} == V{});
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        // Flush the lane counters before narrow lanes can overflow
+                        constexpr size_t FlushEvery = (sizeof(T) == 1) ? 127 : (sizeof(T) == 2) ? 32767 : (size_t(1) << 30);
+                        const V Needle = V{} + Value;
+                        const size_t VecEnd = Count - Count % Lanes;
+                        while (i < VecEnd)
+                        {
+                            MaskV Acc{};
+                            for (size_t Blocks = 0; Blocks < FlushEvery && i < VecEnd; Blocks++, i += Lanes)
+                            {
+                                V Block;
+                                Load(Block, Data + i);
+                                Acc -= (Block == Needle); // matching lanes are -1
+                            }
+                            for (size_t l = 0; l < Lanes; l++)
+                            {
+                                Result += static_cast<size_t>(Acc[l]);
+                            }
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        Result += (Data[i] == Value) ? 1 : 0;
+                    }
+                    return Result;
+                }
+            };
+
+            // Out[i] = In[i] * Scale + Offset
+            struct AffineKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE void Run(const T *In, T *Out, size_t Count, T Scale, T Offset)
+                {
+                    using W = Wrap<T>;
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<W, Bytes>;
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        const V ScaleV = V{} + static_cast<W>(Scale);
+                        const V OffsetV = V{} + static_cast<W>(Offset);
+                        const size_t VecEnd = Count - Count % Lanes;
+                        for (; i < VecEnd; i += Lanes)
+                        {
+                            V Block;
+                            Load(Block, In + i);
+                            Store(Out + i, Block * ScaleV + OffsetV);
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        Out[i] = static_cast<T>(static_cast<W>(In[i]) * static_cast<W>(Scale) + static_cast<W>(Offset));
+                    }
+                }
+            };
+
+            // Out[i] = Op(In[i]); relies on the compiler vectorizing the inlined Op
+            // for whichever instruction set the wrapper is compiled for. No
+            // __restrict: In == Out is allowed, the compiler checks for overlap.
+            struct TransformKernel
+            {
+                template <size_t Bytes, typename T, typename U, typename Op>
+                static ROTCEV_SIMD_INLINE void Run(const T *In, U *Out, size_t Count, Op Operation)
+                {
+                    for (size_t i = 0; i < Count; i++)
+                    {
+                        Out[i] = Operation(In[i]);
+                    }
+                }
+            };
+
+            struct DotKernel
+            {
+                template <size_t Bytes, typename T>
+                static ROTCEV_SIMD_INLINE T Run(const T *Lhs, const T *Rhs, size_t Count)
+                {
+                    using W = Wrap<T>;
+                    W Result{};
+                    size_t i = 0;
+                    if constexpr (Bytes > 0)
+                    {
+                        using V = Vec<W, Bytes>;
+                        constexpr size_t Lanes = Bytes / sizeof(T);
+                        V Acc0{}, Acc1{};
+                        const size_t PairEnd = Count - Count % (2 * Lanes);
+                        for (; i < PairEnd; i += 2 * Lanes)
+                        {
+                            V Lhs0, Lhs1, Rhs0, Rhs1;
+                            Load(Lhs0, Lhs + i);
+                            Load(Lhs1, Lhs + i + Lanes);
+                            Load(Rhs0, Rhs + i);
+                            Load(Rhs1, Rhs + i + Lanes);
+                            Acc0 += Lhs0 * Rhs0;
+                            Acc1 += Lhs1 * Rhs1;
+                        }
+                        Acc0 += Acc1;
+                        for (size_t l = 0; l < Lanes; l++)
+                        {
+                            Result += Acc0[l];
+                        }
+                    }
+                    for (; i < Count; i++)
+                    {
+                        Result += static_cast<W>(Lhs[i]) * static_cast<W>(Rhs[i]);
+                    }
+                    return static_cast<T>(Result);
+                }
+            };
+
+#if ROTCEV_SIMD_X86
+            template <typename Kernel, typename... Args>
+            ROTCEV_SIMD_TARGET_AVX512 auto RunAvx512(Args... Arguments)
+            {
+                return Kernel::template Run<64>(Arguments...);
+            }
+
+            template <typename Kernel, typename... Args>
+            ROTCEV_SIMD_TARGET_AVX2 auto RunAvx2(Args... Arguments)
+            {
+                return Kernel::template Run<32>(Arguments...);
+            }
+
+            // SSE2 is part of the x86-64 baseline, no target attribute needed
+            template <typename Kernel, typename... Args>
+            auto RunSse2(Args... Arguments)
+            {
+                return Kernel::template Run<16>(Arguments...);
+            }
+#endif
+
+            template <typename Kernel, typename... Args>
+            inline auto Dispatch(Args... Arguments)
+            {
+#if ROTCEV_SIMD_X86
+                switch (active_isa())
+                {
+                case isa::avx512: return RunAvx512<Kernel>(Arguments...);
+                case isa::avx2: return RunAvx2<Kernel>(Arguments...);
+                case isa::sse2: return RunSse2<Kernel>(Arguments...);
+                default: break;
+                }
+#endif
+                return Kernel::template Run<0>(Arguments...);
+            }
+
+            template <typename T>
+            constexpr void CheckType()
+            {
+                static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                              "blck::simd kernels need an arithmetic element type");
+            }
+        }
+
+        // Raw pointer kernels, usable on any contiguous buffer
+
+        template <typename T>
+        inline void fill(T *Data, size_t Count, T Value)
+        {
+            detail::CheckType<T>();
+            detail::Dispatch<detail::FillKernel>(Data, Count, Value);
+        }
+
+        template <typename T>
+        inline void iota(T *Data, size_t Count, T Start)
+        {
+            detail::CheckType<T>();
+            detail::Dispatch<detail::IotaKernel>(Data, Count, Start);
+        }
+
+        template <typename T>
+        inline T sum(const T *Data, size_t Count)
+        {
+            detail::CheckType<T>();
+            return detail::Dispatch<detail::SumKernel>(Data, Count);
+        }
+
+        // Smallest element, T{} for an empty range
+        template <typename T>
+        inline T min(const T *Data, size_t Count)
+        {
+            detail::CheckType<T>();
+            return Count ? detail::Dispatch<detail::MinKernel>(Data, Count) : T{};
+        }
+
+        // Largest element, T{} for an empty range
+        template <typename T>
+        inline T max(const T *Data, size_t Count)
+        {
+            detail::CheckType<T>();
+            return Count ? detail::Dispatch<detail::MaxKernel>(Data, Count) : T{};
+        }
+
+        // Index of the first element equal to Value, Count when there is none
+        template <typename T>
+        inline size_t find(const T *Data, size_t Count, T Value)
+        {
+            detail::CheckType<T>();
+            return detail::Dispatch<detail::FindKernel>(Data, Count, Value);
+        }
+
+        template <typename T>
+        inline size_t count(const T *Data, size_t Count, T Value)
+        {
+            detail::CheckType<T>();
+            return detail::Dispatch<detail::CountKernel>(Data, Count, Value);
+        }
+
+        // The transforms work in place (In == Out); partially overlapping ranges are not supported
+        template <typename T>
+        inline void transform(const T *In, T *Out, size_t Count, T Scale, T Offset)
+        {
+            detail::CheckType<T>();
+            detail::Dispatch<detail::AffineKernel>(In, Out, Count, Scale, Offset);
+        }
+
+        template <typename T, typename U, typename Op>
+        inline void transform(const T *In, U *Out, size_t Count, Op Operation)
+        {
+            detail::Dispatch<detail::TransformKernel>(In, Out, Count, Operation);
+        }
+
+        template <typename T>
+        inline T dot(const T *Lhs, const T *Rhs, size_t Count)
+        {
+            detail::CheckType<T>();
+            return detail::Dispatch<detail::DotKernel>(Lhs, Rhs, Count);
+        }
+
+        // rotcev overloads
+
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        inline void fill(rotcev<T, Alloc, GrowthPolicy> &Container, T Value)
+        {
+            fill(Container.data(), Container.size(), Value);
+        }
+
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        inline void iota(rotcev<T, Alloc, GrowthPolicy> &Container, T Start)
+        {
+            iota(Container.data(), Container.size(), Start);
+        }
+
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        inline T sum(const rotcev<T, Alloc, GrowthPolicy> &Container)
+        {
+            return sum(Container.data(), Container.size());
+        }
+
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        inline T min(const rotcev<T, Alloc, GrowthPolicy> &Container)
+        {
+            return min(Container.data(), Container.size());
+        }
+
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        inline T max(const rotcev<T, Alloc, GrowthPolicy> &Container)
+        {
+            return max(Container.data(), Container.size());
+        }
+
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        inline size_t find(const rotcev<T, Alloc, GrowthPolicy> &Container, T Value)
+        {
+            return find(Container.data(), Container.size(), Value);
+        }
+
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        inline size_t count(const rotcev<T, Alloc, GrowthPolicy> &Container, T Value)
+        {
+            return count(Container.data(), Container.size(), Value);
+        }
+
+        // Out is resized to In.size(); In and Out may be the same container
+        template <typename T, typename Alloc, typename GrowthPolicy>
+        inline void transform(const rotcev<T, Alloc, GrowthPolicy> &In, rotcev<T, Alloc, GrowthPolicy> &Out, T Scale, T Offset)
+        {
+            Out.resize_for_overwrite(In.size());
+            transform(In.data(), Out.data(), In.size(), Scale, Offset);
+        }
+
+        template <typename T, typename AllocIn, typename GrowthIn, typename U, typename AllocOut, typename GrowthOut, typename Op>
+        inline void transform(const rotcev<T, AllocIn, GrowthIn> &In, rotcev<U, AllocOut, GrowthOut> &Out, Op Operation)
+        {
+            Out.resize_for_overwrite(In.size());
+            transform(In.data(), Out.data(), In.size(), Operation);
+        }
+
+        // Dot product over the common prefix of both containers
+        template <typename T, typename AllocLhs, typename GrowthLhs, typename AllocRhs, typename GrowthRhs>
+        inline T dot(const rotcev<T, AllocLhs, GrowthLhs> &Lhs, const rotcev<T, AllocRhs, GrowthRhs> &Rhs)
+        {
+            return dot(Lhs.data(), Rhs.data(), Lhs.size() < Rhs.size() ? Lhs.size() : Rhs.size());
+        }
+
+    } // namespace simd
+} // namespace blck
@@ -0,0 +1,392 @@
+#pragma once
+#include "rotcev.hpp"
+#include "segmented_rotcev.hpp"
+#include <tuple>
+
+namespace blck
+{
+    // Contiguous view of one rotcev_soa column, invalidated when the container grows
+    template <typename T>
+    class soa_column
+    {
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using size_type = size_t;
+        using reference = T &;
+        using pointer = T *;
+        using iterator = T *;
+
+        soa_column() noexcept
+        {}
+        soa_column(T *Start, size_t Size) noexcept
+            : m_Start(Start), m_Size(Size)
+        {}
+
+        T *begin() const noexcept
+        {
+            return m_Start;
+        }
+        T *end() const noexcept
+        {
+            return m_Start + m_Size;
+        }
+
+        T &operator[](size_t Index) const noexcept
+        {
+            return m_Start[Index];
+        }
+
+        inline T *data() const noexcept
+        {
+            return m_Start;
+        }
+
+        inline size_t size() const noexcept
+        {
+            return m_Size;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+    private:
+        T *m_Start = nullptr;
+        size_t m_Size = 0;
+    };
+
+    // Structure-of-arrays rotcev: one contiguous column per field, all sharing
+    // a single size and capacity. A loop that reads one field streams through
+    // that column only instead of dragging whole records through the cache,
+    // and column<I>() hands out plain arrays that vectorize (or go straight
+    // into rotcev_simd.hpp).
+    // Rows are addressed through proxies: operator[] and the iterators yield
+    // std::tuple<Ts &...>, so structured bindings work on them. Since rows are
+    // proxies, algorithms that swap whole elements (std::sort) are not supported.
+    // Fields have to be trivially copyable, columns relocate with realloc.
+    template <typename... Ts>
+    class rotcev_soa
+    {
+        static_assert(sizeof...(Ts) > 0, "rotcev_soa needs at least one column");
+        static_assert((std::is_trivially_copyable_v<Ts> && ...), "rotcev_soa columns have to be trivially copyable");
+
+    public:
+        using ValueType = std::tuple<Ts...>;
+        using Reference = std::tuple<Ts &...>;
+        using ConstReference = std::tuple<const Ts &...>;
+        using GrowthPolicyType = default_growth;
+        using Iterator = SegmentedIterator<rotcev_soa<Ts...>>;
+        using ConstIterator = SegmentedIterator<rotcev_soa<Ts...>, true>;
+
+        using value_type = ValueType;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = Reference;
+        using const_reference = ConstReference;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        static constexpr size_t column_count = sizeof...(Ts);
+
+        template <size_t I>
+        using ColumnType = std::tuple_element_t<I, ValueType>;
+    private:
+        using Indices = std::index_sequence_for<Ts...>;
+
+        template <typename T>
+        using ColumnAlloc = malloc_allocator<T>;
+
+        // Grows like a rotcev of whole records would
+        size_t GrowCapacity(size_t MinimumCapacity) const
+        {
+            return default_growth::template next_capacity<ValueType>(m_Size, MinimumCapacity);
+        }
+
+        template <size_t... Is>
+        void ReallocateColumns(size_t NewCapacity, std::index_sequence<Is...>)
+        {
+            // realloc leaves the block alone when it fails, so a throw halfway
+            // leaves the grown columns bigger than m_Capacity, which is harmless
+            ((std::get<Is>(m_Columns) = m_Capacity
+                  ? ColumnAlloc<Ts>().reallocate(std::get<Is>(m_Columns), m_Capacity, NewCapacity)
+                  : ColumnAlloc<Ts>().allocate(NewCapacity)),
+             ...);
+        }
+
+        void Reallocate(size_t NewCapacity)
+        {
+            if (NewCapacity == 0)
+            {
+                ReleaseBuffer();
+                return;
+            }
+            ReallocateColumns(NewCapacity, Indices{});
+            m_Capacity = NewCapacity;
+        }
+
+        template <size_t... Is>
+        void FreeColumns(std::index_sequence<Is...>) noexcept
+        {
+            (ColumnAlloc<Ts>().deallocate(std::get<Is>(m_Columns), m_Capacity), ...);
+            m_Columns = std::tuple<Ts *...>{};
+        }
+
+        void ReleaseBuffer() noexcept
+        {
+            // Unconditional: a failed first allocation can leave some columns allocated at capacity 0
+            FreeColumns(Indices{});
+            m_Size = 0;
+            m_Capacity = 0;
+        }
+
+        template <typename... Args, size_t... Is>
+        Reference ConstructAt(size_t Index, std::index_sequence<Is...>, Args &&...Arguments) noexcept
+        {
+            (::new (static_cast<void *>(std::get<Is>(m_Columns) + Index)) Ts(std::forward<Args>(Arguments)), ...);
+            return Reference(std::get<Is>(m_Columns)[Index]...);
+        }
+
+        template <size_t... Is>
+        Reference RowAt(size_t Index, std::index_sequence<Is...>) noexcept
+        {
+            return Reference(std::get<Is>(m_Columns)[Index]...);
+        }
+
+        template <size_t... Is>
+        ConstReference RowAt(size_t Index, std::index_sequence<Is...>) const noexcept
+        {
+            return ConstReference(std::get<Is>(m_Columns)[Index]...);
+        }
+
+        template <size_t... Is>
+        void CopyColumns(const rotcev_soa &Other, std::index_sequence<Is...>) noexcept
+        {
+            if (Other.m_Size > 0)
+            {
+                (std::memcpy(static_cast<void *>(std::get<Is>(m_Columns)), std::get<Is>(Other.m_Columns), sizeof(Ts) * Other.m_Size), ...);
+            }
+            m_Size = Other.m_Size;
+        }
+
+        template <size_t... Is>
+        void ZeroFill(size_t From, size_t To, std::index_sequence<Is...>) noexcept
+        {
+            (std::uninitialized_value_construct(std::get<Is>(m_Columns) + From, std::get<Is>(m_Columns) + To), ...);
+        }
+
+        void StealFrom(rotcev_soa &Other) noexcept
+        {
+            m_Columns = Other.m_Columns;
+            m_Size = Other.m_Size;
+            m_Capacity = Other.m_Capacity;
+            Other.m_Columns = std::tuple<Ts *...>{};
+            Other.m_Size = 0;
+            Other.m_Capacity = 0;
+        }
+
+    public:
+        rotcev_soa()
+        {}
+        ~rotcev_soa()
+        {
+            ReleaseBuffer();
+        }
+
+        rotcev_soa(const rotcev_soa &other)
+        {
+            if (other.m_Size > 0)
+            {
+                Reallocate(other.m_Size);
+                CopyColumns(other, Indices{});
+            }
+        }
+
+        rotcev_soa(rotcev_soa &&other) noexcept
+        {
+            StealFrom(other);
+        }
+
+        rotcev_soa &operator=(const rotcev_soa &other)
+        {
+            if (this != &other)
+            {
+                m_Size = 0;
+                if (m_Capacity < other.m_Size)
+                {
+                    Reallocate(other.m_Size);
+                }
+                CopyColumns(other, Indices{});
+            }
+            return *this;
+        }
+
+        rotcev_soa &operator=(rotcev_soa &&other) noexcept
+        {
+            if (this != &other)
+            {
+                ReleaseBuffer();
+                StealFrom(other);
+            }
+            return *this;
+        }
+
+        void swap(rotcev_soa &other) noexcept
+        {
+            std::swap(m_Columns, other.m_Columns);
+            std::swap(m_Size, other.m_Size);
+            std::swap(m_Capacity, other.m_Capacity);
+        }
+
+        Iterator begin() noexcept
+        {
+            return Iterator(this, 0);
+        }
+        Iterator end() noexcept
+        {
+            return Iterator(this, m_Size);
+        }
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(this, 0);
+        }
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator(this, m_Size);
+        }
+        ConstIterator cbegin() const noexcept
+        {
+            return ConstIterator(this, 0);
+        }
+        ConstIterator cend() const noexcept
+        {
+            return ConstIterator(this, m_Size);
+        }
+
+        // One value per column
+        template <typename... Args>
+        Reference emplace_back(Args &&...Arguments)
+        {
+            static_assert(sizeof...(Args) == sizeof...(Ts), "rotcev_soa::emplace_back takes one value per column");
+            if (m_Capacity < m_Size + 1)
+            {
+                // Build the row first, the arguments may point into the columns realloc is about to move
+                ValueType Copy(std::forward<Args>(Arguments)...);
+                Reallocate(GrowCapacity(m_Size + 1));
+                return std::apply([this](auto &...Values) { return ConstructAt(m_Size++, Indices{}, Values...); }, Copy);
+            }
+            return ConstructAt(m_Size++, Indices{}, std::forward<Args>(Arguments)...);
+        }
+
+        void push_back(const Ts &...Values)
+        {
+            emplace_back(Values...);
+        }
+
+        void push_back(const ValueType &Row)
+        {
+            std::apply([this](const Ts &...Values) { emplace_back(Values...); }, Row);
+        }
+
+        inline void pop_back() noexcept
+        {
+            if (m_Size > 0)
+            {
+                --m_Size;
+            }
+        }
+
+        void clear() noexcept
+        {
+            m_Size = 0;
+        }
+
+        Reference operator[](size_t Index) noexcept
+        {
+            return RowAt(Index, Indices{});
+        }
+
+        ConstReference operator[](size_t Index) const noexcept
+        {
+            return RowAt(Index, Indices{});
+        }
+
+        template <size_t I>
+        soa_column<ColumnType<I>> column() noexcept
+        {
+            return soa_column<ColumnType<I>>(std::get<I>(m_Columns), m_Size);
+        }
+
+        template <size_t I>
+        soa_column<const ColumnType<I>> column() const noexcept
+        {
+            return soa_column<const ColumnType<I>>(std::get<I>(m_Columns), m_Size);
+        }
+
+        template <size_t I>
+        inline ColumnType<I> *data() noexcept
+        {
+            return std::get<I>(m_Columns);
+        }
+
+        template <size_t I>
+        inline const ColumnType<I> *data() const noexcept
+        {
+            return std::get<I>(m_Columns);
+        }
+
+        inline size_t size() const noexcept
+        {
+            return m_Size;
+        }
+
+        inline size_t capacity() const noexcept
+        {
+            return m_Capacity;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+        void reserve(size_t NewCapacity)
+        {
+            if (NewCapacity > m_Capacity)
+            {
+                Reallocate(NewCapacity);
+            }
+        }
+
+        void shrink_to_fit()
+        {
+            if (m_Capacity > m_Size)
+            {
+                Reallocate(m_Size);
+            }
+        }
+
+        // New rows are value-initialized (zero for arithmetic fields)
+        void resize(size_t NewSize)
+        {
+            if (NewSize > m_Size)
+            {
+                reserve(NewSize);
+                ZeroFill(m_Size, NewSize, Indices{});
+            }
+            m_Size = NewSize;
+        }
+
+    private:
+        std::tuple<Ts *...> m_Columns{};
+        size_t m_Size = 0;
+        size_t m_Capacity = 0; // in rows
+    };
+
+    template <typename... Ts>
+    inline void swap(rotcev_soa<Ts...> &Lhs, rotcev_soa<Ts...> &Rhs) noexcept
+    {
+        Lhs.swap(Rhs);
+    }
+
+} // namespace blck
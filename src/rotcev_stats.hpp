@@ -0,0 +1,354 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(ROTCEV_STATS)
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+#endif
+
+namespace blck
+{
+    // Allocation and relocation counters of every rotcev, global and per
+    // element type. The hooks in rotcev only run on its allocation paths (never
+    // on a push_back that fits) and compile to nothing unless ROTCEV_STATS is
+    // defined; the CMake Profile build and -DROTCEV_STATS=ON define it.
+    // stats::collect() is always available and returns zeros when disabled,
+    // so a service can export the numbers without #ifdefs of its own.
+    namespace stats
+    {
+#if defined(ROTCEV_STATS)
+        constexpr bool enabled = true;
+#else
+        constexpr bool enabled = false;
+#endif
+
+        struct counters
+        {
+            uint64_t allocations = 0;     // buffers obtained from the allocator
+            uint64_t frees = 0;           // buffers handed back
+            uint64_t reallocations = 0;   // times an existing buffer was grown or shrunk
+            uint64_t bytes_relocated = 0; // moved by memcpy or a realloc that changed address
+            uint64_t element_moves = 0;   // elements move-constructed one by one while relocating
+            uint64_t peak_capacity_bytes = 0; // largest single buffer
+            uint64_t live_bytes = 0;      // capacity currently allocated
+            uint64_t released_bytes = 0;  // capacity of buffers at destruction/clear-and-release
+            uint64_t slack_bytes = 0;     // unused part of released_bytes
+
+            counters &operator+=(const counters &Other) noexcept
+            {
+                allocations += Other.allocations;
+                frees += Other.frees;
+                reallocations += Other.reallocations;
+                bytes_relocated += Other.bytes_relocated;
+                element_moves += Other.element_moves;
+                peak_capacity_bytes = std::max(peak_capacity_bytes, Other.peak_capacity_bytes);
+                live_bytes += Other.live_bytes;
+                released_bytes += Other.released_bytes;
+                slack_bytes += Other.slack_bytes;
+                return *this;
+            }
+
+            // Share of released capacity that was never used
+            double slack_ratio() const noexcept
+            {
+                return released_bytes ? static_cast<double>(slack_bytes) / static_cast<double>(released_bytes) : 0.0;
+            }
+        };
+
+        struct type_counters
+        {
+            std::string type;
+            size_t element_size = 0;
+            counters values;
+        };
+
+        struct snapshot
+        {
+            counters total;
+            uint64_t peak_live_bytes = 0; // highest live_bytes over all types at once
+            std::vector<type_counters> types;
+        };
+
+        namespace detail
+        {
+#if defined(ROTCEV_STATS)
+            struct AtomicCounters
+            {
+                std::atomic<uint64_t> Allocations{0};
+                std::atomic<uint64_t> Frees{0};
+                std::atomic<uint64_t> Reallocations{0};
+                std::atomic<uint64_t> BytesRelocated{0};
+                std::atomic<uint64_t> ElementMoves{0};
+                std::atomic<uint64_t> PeakCapacityBytes{0};
+                std::atomic<uint64_t> LiveBytes{0};
+                std::atomic<uint64_t> ReleasedBytes{0};
+                std::atomic<uint64_t> SlackBytes{0};
+            };
+
+            struct TypeEntry
+            {
+                const char *Name;
+                size_t ElementSize;
+                AtomicCounters Counters;
+            };
+
+            struct Registry
+            {
+                std::mutex Lock;
+                std::vector<TypeEntry *> Types;
+                std::atomic<uint64_t> LiveBytes{0};
+                std::atomic<uint64_t> PeakLiveBytes{0};
+            };
+
+            // Never destroyed: containers with static storage still report while the program exits
+            inline Registry &GetRegistry()
+            {
+                static Registry *Instance = new Registry();
+                return *Instance;
+            }
+
+            inline TypeEntry &Register(const char *Name, size_t ElementSize)
+            {
+                Registry &Global = GetRegistry();
+                TypeEntry *Entry = new TypeEntry{Name, ElementSize, {}};
+                std::lock_guard<std::mutex> Guard(Global.Lock);
+                Global.Types.push_back(Entry);
+                return *Entry;
+            }
+
+            template <typename T>
+            inline TypeEntry &EntryFor()
+            {
+                static TypeEntry &Entry = Register(typeid(T).name(), sizeof(T));
+                return Entry;
+            }
+
+            inline void RaiseTo(std::atomic<uint64_t> &Peak, uint64_t Value) noexcept
+            {
+                uint64_t Current = Peak.load(std::memory_order_relaxed);
+                while (Current < Value && !Peak.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+                {
+                }
+            }
+
+            inline void AddLive(AtomicCounters &Counters, uint64_t Bytes) noexcept
+            {
+                Counters.LiveBytes.fetch_add(Bytes, std::memory_order_relaxed);
+                Registry &Global = GetRegistry();
+                uint64_t Live = Global.LiveBytes.fetch_add(Bytes, std::memory_order_relaxed) + Bytes;
+                RaiseTo(Global.PeakLiveBytes, Live);
+                RaiseTo(Counters.PeakCapacityBytes, Bytes);
+            }
+
+            inline void SubtractLive(AtomicCounters &Counters, uint64_t Bytes) noexcept
+            {
+                Counters.LiveBytes.fetch_sub(Bytes, std::memory_order_relaxed);
+                GetRegistry().LiveBytes.fetch_sub(Bytes, std::memory_order_relaxed);
+            }
+
+            inline std::string Demangle(const char *Name)
+            {
+#if defined(__GNUG__)
+                int Status = 0;
+                std::unique_ptr<char, void (*)(void *)> Readable(abi::__cxa_demangle(Name, nullptr, nullptr, &Status), std::free);
+                if (Status == 0 && Readable)
+                {
+                    return Readable.get();
+                }
+#endif
+                return Name;
+            }
+
+            inline counters Load(const AtomicCounters &Counters) noexcept
+            {
+                counters Values;
+                Values.allocations = Counters.Allocations.load(std::memory_order_relaxed);
+                Values.frees = Counters.Frees.load(std::memory_order_relaxed);
+                Values.reallocations = Counters.Reallocations.load(std::memory_order_relaxed);
+                Values.bytes_relocated = Counters.BytesRelocated.load(std::memory_order_relaxed);
+                Values.element_moves = Counters.ElementMoves.load(std::memory_order_relaxed);
+                Values.peak_capacity_bytes = Counters.PeakCapacityBytes.load(std::memory_order_relaxed);
+                Values.live_bytes = Counters.LiveBytes.load(std::memory_order_relaxed);
+                Values.released_bytes = Counters.ReleasedBytes.load(std::memory_order_relaxed);
+                Values.slack_bytes = Counters.SlackBytes.load(std::memory_order_relaxed);
+                return Values;
+            }
+#endif
+
+            // Called by rotcev<T>; capacities and sizes are in elements
+            template <typename T>
+            struct Hooks
+            {
+#if defined(ROTCEV_STATS)
+                // A new buffer of Capacity elements
+                static void Allocated(size_t Capacity) noexcept
+                {
+                    AtomicCounters &Counters = EntryFor<T>().Counters;
+                    Counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+                    AddLive(Counters, sizeof(T) * Capacity);
+                }
+
+                static void Freed(size_t Capacity) noexcept
+                {
+                    AtomicCounters &Counters = EntryFor<T>().Counters;
+                    Counters.Frees.fetch_add(1, std::memory_order_relaxed);
+                    SubtractLive(Counters, sizeof(T) * Capacity);
+                }
+
+                // Count elements went from an old buffer to a new one, Elementwise when move-constructed
+                static void Relocated(size_t Count, bool Elementwise) noexcept
+                {
+                    AtomicCounters &Counters = EntryFor<T>().Counters;
+                    Counters.Reallocations.fetch_add(1, std::memory_order_relaxed);
+                    if (Elementwise)
+                    {
+                        Counters.ElementMoves.fetch_add(Count, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        Counters.BytesRelocated.fetch_add(sizeof(T) * Count, std::memory_order_relaxed);
+                    }
+                }
+
+                // The allocator resized the buffer itself; Moved when the address changed
+                static void Resized(size_t OldCapacity, size_t NewCapacity, size_t Count, bool Moved) noexcept
+                {
+                    AtomicCounters &Counters = EntryFor<T>().Counters;
+                    Counters.Reallocations.fetch_add(1, std::memory_order_relaxed);
+                    if (Moved)
+                    {
+                        Counters.BytesRelocated.fetch_add(sizeof(T) * Count, std::memory_order_relaxed);
+                    }
+                    SubtractLive(Counters, sizeof(T) * OldCapacity);
+                    AddLive(Counters, sizeof(T) * NewCapacity);
+                }
+
+                // The container gives up a buffer holding Size of Capacity elements
+                static void Released(size_t Capacity, size_t Size) noexcept
+                {
+                    AtomicCounters &Counters = EntryFor<T>().Counters;
+                    Counters.ReleasedBytes.fetch_add(sizeof(T) * Capacity, std::memory_order_relaxed);
+                    Counters.SlackBytes.fetch_add(sizeof(T) * (Capacity - Size), std::memory_order_relaxed);
+                }
+#else
+                static void Allocated(size_t) noexcept
+                {}
+                static void Freed(size_t) noexcept
+                {}
+                static void Relocated(size_t, bool) noexcept
+                {}
+                static void Resized(size_t, size_t, size_t, bool) noexcept
+                {}
+                static void Released(size_t, size_t) noexcept
+                {}
+#endif
+            };
+        }
+
+        // Current values; types are sorted by reallocations, most first, since
+        // those are the containers that would gain from a reserve()
+        inline snapshot collect()
+        {
+            snapshot Result;
+#if defined(ROTCEV_STATS)
+            detail::Registry &Global = detail::GetRegistry();
+            std::vector<detail::TypeEntry *> Types;
+            {
+                std::lock_guard<std::mutex> Guard(Global.Lock);
+                Types = Global.Types;
+            }
+            for (detail::TypeEntry *Entry : Types)
+            {
+                type_counters Type;
+                Type.type = detail::Demangle(Entry->Name);
+                Type.element_size = Entry->ElementSize;
+                Type.values = detail::Load(Entry->Counters);
+                Result.total += Type.values;
+                Result.types.push_back(std::move(Type));
+            }
+            Result.peak_live_bytes = Global.PeakLiveBytes.load(std::memory_order_relaxed);
+            std::sort(Result.types.begin(), Result.types.end(), [](const type_counters &Lhs, const type_counters &Rhs) {
+                return Lhs.values.reallocations > Rhs.values.reallocations;
+            });
+#endif
+            return Result;
+        }
+
+        // Zeroes the event counters; live bytes stay, they describe buffers that still exist
+        inline void reset() noexcept
+        {
+#if defined(ROTCEV_STATS)
+            detail::Registry &Global = detail::GetRegistry();
+            std::lock_guard<std::mutex> Guard(Global.Lock);
+            for (detail::TypeEntry *Entry : Global.Types)
+            {
+                detail::AtomicCounters &Counters = Entry->Counters;
+                for (std::atomic<uint64_t> *Counter : {&Counters.Allocations, &Counters.Frees, &Counters.Reallocations,
+                                                       &Counters.BytesRelocated, &Counters.ElementMoves, &Counters.ReleasedBytes,
+                                                       &Counters.SlackBytes})
+                {
+                    Counter->store(0, std::memory_order_relaxed);
+                }
+                Counters.PeakCapacityBytes.store(Counters.LiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            Global.PeakLiveBytes.store(Global.LiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+#endif
+        }
+
+        namespace detail
+        {
+            inline void WriteJsonCounters(std::ostream &Out, const counters &Values)
+            {
+                Out << "\"allocations\": " << Values.allocations << ", \"frees\": " << Values.frees
+                    << ", \"reallocations\": " << Values.reallocations << ", \"bytes_relocated\": " << Values.bytes_relocated
+                    << ", \"element_moves\": " << Values.element_moves << ", \"peak_capacity_bytes\": " << Values.peak_capacity_bytes
+                    << ", \"live_bytes\": " << Values.live_bytes << ", \"released_bytes\": " << Values.released_bytes
+                    << ", \"slack_bytes\": " << Values.slack_bytes;
+            }
+
+            inline std::string JsonEscape(const std::string &Text)
+            {
+                std::string Escaped;
+                for (char Character : Text)
+                {
+                    if (Character == '"' || Character == '\\')
+                    {
+                        Escaped += '\\';
+                    }
+                    Escaped += Character;
+                }
+                return Escaped;
+            }
+        }
+
+        // One JSON object, for shipping to a metrics pipeline
+        inline void write_json(std::ostream &Out, const snapshot &Snapshot)
+        {
+            Out << "{\"enabled\": " << (enabled ? "true" : "false") << ", \"peak_live_bytes\": " << Snapshot.peak_live_bytes
+                << ", \"total\": {";
+            detail::WriteJsonCounters(Out, Snapshot.total);
+            Out << "}, \"types\": [";
+            for (size_t i = 0; i < Snapshot.types.size(); i++)
+            {
+                const type_counters &Type = Snapshot.types[i];
+                Out << (i ? ", " : "") << "{\"type\": \"" << detail::JsonEscape(Type.type)
+                    << "\", \"element_size\": " << Type.element_size << ", ";
+                detail::WriteJsonCounters(Out, Type.values);
+                Out << "}";
+            }
+            Out << "]}";
+        }
+    }
+
+} // namespace blck
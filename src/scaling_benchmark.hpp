@@ -0,0 +1,239 @@
+#pragma once
+#include "rotcev.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+// Rotcev_Profiling -scaling: the FillArray workloads on 1..N threads at once,
+// every thread pinned to its own core and building and destroying its own
+// containers. The work per thread is fixed, so perfect scaling keeps the time
+// flat and multiplies the throughput; what is lost on the way is mostly the
+// allocator. glibc malloc hands threads separate arenas (up to 8 per core by
+// default); --arena-max 1 forces them onto one locked arena to show what
+// contention on it costs. Voluntary context switches are threads sleeping on a
+// lock, system time is mmap/munmap/madvise work in the kernel.
+
+struct ScalingOptions {
+    // Highest thread count, 0 for one per core we may run on
+    size_t max_threads = 0;
+    // glibc M_ARENA_MAX, 0 keeps the default
+    int arena_max = 0;
+    // Timed runs per row, the median is kept
+    int runs = 3;
+};
+
+// Cores this process may run on, in order
+inline std::vector<int> allowedCores() {
+    std::vector<int> cores;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) cores.push_back(cpu);
+        }
+    }
+    if (cores.empty()) cores.push_back(0);
+    return cores;
+}
+
+// Arenas glibc malloc has created so far, the main one included
+inline int mallocArenaCount() {
+    char* buffer = nullptr;
+    size_t length = 0;
+    FILE* stream = open_memstream(&buffer, &length);
+    if (!stream) return 0;
+    malloc_info(0, stream);
+    std::fclose(stream);
+    int arenas = 0;
+    for (const char* at = buffer; (at = std::strstr(at, "<heap nr=")) != nullptr; at++) arenas++;
+    std::free(buffer);
+    return arenas;
+}
+
+// The workloads, written once for rotcev and std::vector. Each returns the
+// elements it pushed so the optimizer keeps the containers.
+
+// FillArray<int>: 10000 ints pushed one by one, no reserve
+template <template <typename...> class Vec>
+size_t scalingInsertion(size_t repetitions) {
+    size_t pushed = 0;
+    for (size_t r = 0; r < repetitions; r++) {
+        Vec<int> values;
+        for (size_t i = 0; i < 10000; i++) values.push_back(static_cast<int>(i));
+        pushed += values.size();
+    }
+    return pushed;
+}
+
+// FillArray<rotcev<int>>: 10000-int rows moved into a growing outer container
+template <template <typename...> class Vec>
+size_t scalingNested(size_t repetitions) {
+    size_t pushed = 0;
+    for (size_t r = 0; r < repetitions; r++) {
+        Vec<Vec<int>> rows;
+        for (size_t i = 0; i < 20; i++) {
+            Vec<int> row;
+            for (size_t j = 0; j < 10000; j++) row.push_back(static_cast<int>(j));
+            rows.push_back(std::move(row));
+        }
+        pushed += rows.size() * 10000;
+    }
+    return pushed;
+}
+
+// Many 8-int rows, one heap block each: the allocator does most of the work
+template <template <typename...> class Vec>
+size_t scalingShortRows(size_t repetitions) {
+    size_t pushed = 0;
+    for (size_t r = 0; r < repetitions; r++) {
+        Vec<Vec<int>> rows;
+        for (size_t i = 0; i < 10000; i++) {
+            Vec<int> row;
+            for (int j = 0; j < 8; j++) row.push_back(j);
+            rows.push_back(std::move(row));
+        }
+        pushed += rows.size() * 8;
+    }
+    return pushed;
+}
+
+struct ScalingSample {
+    double seconds = 0.0;
+    size_t elements = 0;
+    double voluntary_switches = 0.0; // per thread
+    double system_share = 0.0;       // system time / (user + system)
+};
+
+// Runs work(repetitions) on every thread at once; the time is from the
+// common start to the last thread done
+template <typename Work>
+ScalingSample runOnThreads(size_t threads, const std::vector<int>& cores, size_t repetitions, Work work) {
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<size_t> pushed(threads, 0);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cores[t % cores.size()], &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            pushed[t] = work(repetitions);
+        });
+    }
+    while (ready.load() < threads) std::this_thread::yield();
+
+    rusage before{}, after{};
+    getrusage(RUSAGE_SELF, &before);
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) worker.join();
+    auto stop = std::chrono::steady_clock::now();
+    getrusage(RUSAGE_SELF, &after);
+
+    auto seconds = [](const timeval& time) {
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) / 1e6;
+    };
+    double user = seconds(after.ru_utime) - seconds(before.ru_utime);
+    double system = seconds(after.ru_stime) - seconds(before.ru_stime);
+    ScalingSample sample;
+    sample.seconds = std::chrono::duration<double>(stop - start).count();
+    for (size_t count : pushed) sample.elements += count;
+    sample.voluntary_switches = static_cast<double>(after.ru_nvcsw - before.ru_nvcsw) / static_cast<double>(threads);
+    sample.system_share = user + system > 0 ? system / (user + system) : 0.0;
+    return sample;
+}
+
+template <typename Work>
+ScalingSample medianSample(size_t threads, const std::vector<int>& cores, size_t repetitions, int runs, Work work) {
+    std::vector<ScalingSample> samples;
+    for (int run = 0; run < runs; run++) samples.push_back(runOnThreads(threads, cores, repetitions, work));
+    std::sort(samples.begin(), samples.end(),
+              [](const ScalingSample& a, const ScalingSample& b) { return a.seconds < b.seconds; });
+    return samples[samples.size() / 2];
+}
+
+// One table: throughput in million elements per second, efficiency against
+// the single thread (throughput / (threads * single thread throughput)),
+// voluntary switches per thread and the system time share, rotcev / std
+template <typename RotcevWork, typename StdWork>
+void printScalingWorkload(const std::string& label, size_t repetitions, const std::vector<size_t>& thread_counts,
+                          const std::vector<int>& cores, const ScalingOptions& options, RotcevWork rotcev_work,
+                          StdWork std_work) {
+    std::cout << label << "\n"
+              << std::setw(8) << "threads" << std::setw(22) << "Melem/s" << std::setw(18) << "efficiency"
+              << std::setw(20) << "vol. switches" << std::setw(18) << "system time" << std::setw(8) << "arenas"
+              << "\n";
+
+    // Untimed round so the first row does not pay for page faults of a fresh heap
+    runOnThreads(1, cores, repetitions, rotcev_work);
+    runOnThreads(1, cores, repetitions, std_work);
+
+    double rotcev_single = 0.0, std_single = 0.0;
+    for (size_t threads : thread_counts) {
+        ScalingSample rotcev_sample = medianSample(threads, cores, repetitions, options.runs, rotcev_work);
+        ScalingSample std_sample = medianSample(threads, cores, repetitions, options.runs, std_work);
+        double rotcev_rate = static_cast<double>(rotcev_sample.elements) / rotcev_sample.seconds / 1e6;
+        double std_rate = static_cast<double>(std_sample.elements) / std_sample.seconds / 1e6;
+        double thread_count = static_cast<double>(threads);
+        if (threads == thread_counts.front()) {
+            rotcev_single = rotcev_rate / thread_count;
+            std_single = std_rate / thread_count;
+        }
+
+        std::ostringstream rate, efficiency, switches, system;
+        rate << std::fixed << std::setprecision(1) << rotcev_rate << " / " << std_rate;
+        efficiency << std::fixed << std::setprecision(0) << 100.0 * rotcev_rate / (thread_count * rotcev_single) << "% / "
+                   << 100.0 * std_rate / (thread_count * std_single) << "%";
+        switches << std::fixed << std::setprecision(1) << rotcev_sample.voluntary_switches << " / "
+                 << std_sample.voluntary_switches;
+        system << std::fixed << std::setprecision(0) << 100.0 * rotcev_sample.system_share << "% / "
+               << 100.0 * std_sample.system_share << "%";
+        std::cout << std::setw(8) << threads << std::setw(22) << rate.str() << std::setw(18) << efficiency.str()
+                  << std::setw(20) << switches.str() << std::setw(18) << system.str() << std::setw(8)
+                  << mallocArenaCount() << "\n";
+    }
+}
+
+inline int StartScalingBenchmark(const ScalingOptions& options) {
+    // Has to happen before the first extra thread allocates, arenas are never given back
+    if (options.arena_max > 0) mallopt(M_ARENA_MAX, options.arena_max);
+
+    std::vector<int> cores = allowedCores();
+    size_t max_threads = options.max_threads ? options.max_threads : cores.size();
+    // 1, 2, 4, ... and the maximum itself
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    std::cout << cores.size() << " core(s) available, threads pinned round-robin, malloc arenas: "
+              << (options.arena_max > 0 ? "at most " + std::to_string(options.arena_max) : std::string("glibc default"))
+              << "\nfigures are rotcev / std::vector, the work per thread is fixed\n";
+    if (max_threads > cores.size()) {
+        std::cout << "more threads than cores: rows past " << cores.size() << " share cores\n";
+    }
+
+    printScalingWorkload("insertion (FillArray<int>, 10000 ints per container)", 400, thread_counts, cores, options,
+                         scalingInsertion<blck::rotcev>, scalingInsertion<std::vector>);
+    printScalingWorkload("nested fill (FillArray<rotcev<int>>, 20 rows of 10000)", 20, thread_counts, cores,
+                         options, scalingNested<blck::rotcev>, scalingNested<std::vector>);
+    printScalingWorkload("short rows (10000 rows of 8 ints, one block per row)", 50, thread_counts, cores, options,
+                         scalingShortRows<blck::rotcev>, scalingShortRows<std::vector>);
+    return 0;
+}
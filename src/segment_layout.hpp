@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace blck
+{
+    namespace detail
+    {
+        // Largest power of two number of T that fits in Bytes (at least one)
+        template <typename T>
+        constexpr size_t SegmentElementsFor(size_t Bytes) noexcept
+        {
+            size_t Elements = Bytes / sizeof(T);
+            size_t Result = 1;
+            while (Result * 2 <= Elements)
+            {
+                Result *= 2;
+            }
+            return Result;
+        }
+
+        // Index math for containers built from power-of-two segments that never move.
+        // Segment k holds FirstSegmentSize << k elements and starts at element
+        // FirstSegmentSize * (2^k - 1), so the total capacity doubles with every
+        // new segment and any index maps to (segment, offset) in O(1).
+        template <size_t FirstSegmentSize>
+        struct SegmentLayout
+        {
+            static_assert(FirstSegmentSize > 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0,
+                          "FirstSegmentSize has to be a power of two");
+
+            static constexpr size_t FirstShift = static_cast<size_t>(__builtin_ctzll(FirstSegmentSize));
+
+            // Enough segments to address every size_t index
+            static constexpr size_t MaxSegments = 64 - FirstShift;
+
+            static size_t SegmentOf(size_t Index) noexcept
+            {
+                uint64_t Shifted = static_cast<uint64_t>(Index) + FirstSegmentSize;
+                return static_cast<size_t>(63 - __builtin_clzll(Shifted)) - FirstShift;
+            }
+
+            static constexpr size_t SegmentBase(size_t Segment) noexcept
+            {
+                return FirstSegmentSize * ((size_t(1) << Segment) - 1);
+            }
+
+            static constexpr size_t SegmentCapacity(size_t Segment) noexcept
+            {
+                return FirstSegmentSize << Segment;
+            }
+
+            // Total capacity of segments [0, SegmentCount)
+            static constexpr size_t CapacityOf(size_t SegmentCount) noexcept
+            {
+                return SegmentBase(SegmentCount);
+            }
+        };
+    }
+
+} // namespace blck
@@ -0,0 +1,540 @@
+#pragma once
+#include "rotcev.hpp"
+#include "segment_layout.hpp"
+
+namespace blck
+{
+    // Random-access iterator over a segmented container, same interface as
+    // RotcevIterator but walking (container, index) instead of a raw pointer
+    // since the elements are not contiguous.
+    // Dereferencing yields whatever the container's operator[] returns, which
+    // also covers proxy references (rotcev_soa rows).
+    template <typename Container, bool IsConst = false>
+    class SegmentedIterator
+    {
+    public:
+        using ValueType = typename Container::ValueType;
+        using PointerType = std::conditional_t<IsConst, const ValueType *, ValueType *>;
+        using ContainerPointer = std::conditional_t<IsConst, const Container *, Container *>;
+        using ReferenceType = decltype((*std::declval<ContainerPointer>())[size_t()]);
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<ValueType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = PointerType;
+        using reference = ReferenceType;
+    public:
+        SegmentedIterator() noexcept
+            : m_Container(nullptr), m_Index(0) {}
+
+        SegmentedIterator(ContainerPointer Owner, size_t Index) noexcept
+            : m_Container(Owner), m_Index(Index) {}
+
+        // iterator -> const_iterator
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        SegmentedIterator(const SegmentedIterator<Container, OtherConst> &Other) noexcept
+            : m_Container(Other.container()), m_Index(Other.index()) {}
+
+        SegmentedIterator& operator++() noexcept
+        {
+            m_Index++;
+            return *this;
+        }
+
+        SegmentedIterator operator++(int) noexcept
+        {
+            SegmentedIterator iterator = *this;
+            ++(*this);
+            return iterator;
+        }
+
+        SegmentedIterator& operator--() noexcept
+        {
+            m_Index--;
+            return *this;
+        }
+
+        SegmentedIterator operator--(int) noexcept
+        {
+            SegmentedIterator iterator = *this;
+            --(*this);
+            return iterator;
+        }
+
+        SegmentedIterator& operator+=(difference_type Offset) noexcept
+        {
+            m_Index += Offset;
+            return *this;
+        }
+
+        SegmentedIterator& operator-=(difference_type Offset) noexcept
+        {
+            m_Index -= Offset;
+            return *this;
+        }
+
+        SegmentedIterator operator+(difference_type Offset) const noexcept
+        {
+            return SegmentedIterator(m_Container, m_Index + Offset);
+        }
+
+        friend SegmentedIterator operator+(difference_type Offset, const SegmentedIterator& Iterator) noexcept
+        {
+            return Iterator + Offset;
+        }
+
+        SegmentedIterator operator-(difference_type Offset) const noexcept
+        {
+            return SegmentedIterator(m_Container, m_Index - Offset);
+        }
+
+        // Differences and comparisons also mix iterator and const_iterator
+        template <bool OtherConst>
+        difference_type operator-(const SegmentedIterator<Container, OtherConst>& Other) const noexcept
+        {
+            return static_cast<difference_type>(m_Index) - static_cast<difference_type>(Other.index());
+        }
+
+        ReferenceType operator[](difference_type Offset) const noexcept
+        {
+            return (*m_Container)[m_Index + Offset];
+        }
+
+        template <bool OtherConst>
+        bool operator==(const SegmentedIterator<Container, OtherConst>& Other) const noexcept
+        {
+            return m_Index == Other.index();
+        }
+
+        template <bool OtherConst>
+        bool operator!=(const SegmentedIterator<Container, OtherConst>& Other) const noexcept
+        {
+            return m_Index != Other.index();
+        }
+
+        template <bool OtherConst>
+        bool operator<(const SegmentedIterator<Container, OtherConst>& Other) const noexcept
+        {
+            return m_Index < Other.index();
+        }
+
+        template <bool OtherConst>
+        bool operator>(const SegmentedIterator<Container, OtherConst>& Other) const noexcept
+        {
+            return m_Index > Other.index();
+        }
+
+        template <bool OtherConst>
+        bool operator<=(const SegmentedIterator<Container, OtherConst>& Other) const noexcept
+        {
+            return m_Index <= Other.index();
+        }
+
+        template <bool OtherConst>
+        bool operator>=(const SegmentedIterator<Container, OtherConst>& Other) const noexcept
+        {
+            return m_Index >= Other.index();
+        }
+
+        ReferenceType operator*() const noexcept
+        {
+            return (*m_Container)[m_Index];
+        }
+
+        PointerType operator->() const noexcept
+        {
+            return &(*m_Container)[m_Index];
+        }
+
+        ContainerPointer container() const noexcept
+        {
+            return m_Container;
+        }
+
+        size_t index() const noexcept
+        {
+            return m_Index;
+        }
+
+    private:
+        ContainerPointer m_Container;
+        size_t m_Index;
+    };
+
+    // rotcev-like container made of power-of-two segments.
+    // Growing allocates one more segment (twice the size of the previous one)
+    // and never touches the existing elements: addresses stay stable and
+    // push_back has no relocation spike, its worst case is one allocation.
+    // Indexing is O(1) through the segment math in segment_layout.hpp.
+    template <typename T, typename Alloc = malloc_allocator<T>, size_t FirstSegmentSize = detail::SegmentElementsFor<T>(4096)>
+    class segmented_rotcev
+    {
+    public:
+        using ValueType = T;
+        using AllocatorType = Alloc;
+        using Iterator = SegmentedIterator<segmented_rotcev<T, Alloc, FirstSegmentSize>>;
+        using ConstIterator = SegmentedIterator<segmented_rotcev<T, Alloc, FirstSegmentSize>, true>;
+        using ReverseIterator = std::reverse_iterator<Iterator>;
+        using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+        using reverse_iterator = ReverseIterator;
+        using const_reverse_iterator = ConstReverseIterator;
+    private:
+        using AllocTraits = std::allocator_traits<Alloc>;
+        using Layout = detail::SegmentLayout<FirstSegmentSize>;
+
+        T *SlotFor(size_t Index) const noexcept
+        {
+            size_t Segment = Layout::SegmentOf(Index);
+            return m_Segments[Segment] + (Index - Layout::SegmentBase(Segment));
+        }
+
+        // Makes room for one more element, at most one allocation and no moves
+        T *NextSlot()
+        {
+            if (m_Size == Layout::CapacityOf(m_SegmentCount))
+            {
+                m_Segments[m_SegmentCount] = AllocTraits::allocate(m_Allocator, Layout::SegmentCapacity(m_SegmentCount));
+                ++m_SegmentCount;
+            }
+            return SlotFor(m_Size);
+        }
+
+        void DestroyRange(size_t From, size_t To) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (size_t i = From; i < To; i++)
+                {
+                    AllocTraits::destroy(m_Allocator, SlotFor(i));
+                }
+            }
+        }
+
+        // Frees segments [FirstUnused, m_SegmentCount)
+        void ReleaseSegments(size_t FirstUnused) noexcept
+        {
+            while (m_SegmentCount > FirstUnused)
+            {
+                --m_SegmentCount;
+                AllocTraits::deallocate(m_Allocator, m_Segments[m_SegmentCount], Layout::SegmentCapacity(m_SegmentCount));
+                m_Segments[m_SegmentCount] = nullptr;
+            }
+        }
+
+        void CopyFrom(const segmented_rotcev &Other)
+        {
+            reserve(Other.m_Size);
+            for (size_t Segment = 0; Layout::SegmentBase(Segment) < Other.m_Size; Segment++)
+            {
+                size_t Base = Layout::SegmentBase(Segment);
+                size_t Count = std::min(Other.m_Size - Base, Layout::SegmentCapacity(Segment));
+                if constexpr (std::is_trivially_copyable_v<T>)
+                {
+                    std::memcpy(static_cast<void *>(m_Segments[Segment]), Other.m_Segments[Segment], Count * sizeof(T));
+                    m_Size = Base + Count;
+                }
+                else
+                {
+                    for (size_t i = 0; i < Count; i++)
+                    {
+                        AllocTraits::construct(m_Allocator, m_Segments[Segment] + i, Other.m_Segments[Segment][i]);
+                        ++m_Size;
+                    }
+                }
+            }
+        }
+
+        void StealFrom(segmented_rotcev &Other) noexcept
+        {
+            for (size_t Segment = 0; Segment < Other.m_SegmentCount; Segment++)
+            {
+                m_Segments[Segment] = Other.m_Segments[Segment];
+                Other.m_Segments[Segment] = nullptr;
+            }
+            m_SegmentCount = Other.m_SegmentCount;
+            m_Size = Other.m_Size;
+            Other.m_SegmentCount = 0;
+            Other.m_Size = 0;
+        }
+
+    public:
+        segmented_rotcev()
+        {}
+        explicit segmented_rotcev(const Alloc &Allocator)
+            : m_Allocator(Allocator)
+        {}
+        ~segmented_rotcev()
+        {
+            DestroyRange(0, m_Size);
+            ReleaseSegments(0);
+        }
+
+        segmented_rotcev(const segmented_rotcev &other)
+            : m_Allocator(AllocTraits::select_on_container_copy_construction(other.m_Allocator))
+        {
+            CopyFrom(other);
+        }
+
+        segmented_rotcev(segmented_rotcev &&other) noexcept
+            : m_Allocator(std::move(other.m_Allocator))
+        {
+            StealFrom(other);
+        }
+
+        segmented_rotcev &operator=(const segmented_rotcev &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+                {
+                    if (m_Allocator != other.m_Allocator)
+                    {
+                        ReleaseSegments(0);
+                    }
+                    m_Allocator = other.m_Allocator;
+                }
+                CopyFrom(other);
+            }
+            return *this;
+        }
+
+        segmented_rotcev &operator=(segmented_rotcev &&other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+        {
+            if (this != &other)
+            {
+                clear();
+                if constexpr (!AllocTraits::propagate_on_container_move_assignment::value)
+                {
+                    if (m_Allocator != other.m_Allocator)
+                    {
+                        // Different memory resources, fall back to moving element by element
+                        reserve(other.m_Size);
+                        for (size_t i = 0; i < other.m_Size; i++)
+                        {
+                            emplace_back(std::move(other[i]));
+                        }
+                        other.clear();
+                        return *this;
+                    }
+                }
+                ReleaseSegments(0);
+                if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+                {
+                    m_Allocator = std::move(other.m_Allocator);
+                }
+                StealFrom(other);
+            }
+            return *this;
+        }
+
+        void swap(segmented_rotcev &other) noexcept
+        {
+            if constexpr (AllocTraits::propagate_on_container_swap::value)
+            {
+                std::swap(m_Allocator, other.m_Allocator);
+            }
+            std::swap(m_Segments, other.m_Segments);
+            std::swap(m_SegmentCount, other.m_SegmentCount);
+            std::swap(m_Size, other.m_Size);
+        }
+
+        Iterator begin()
+        {
+            return Iterator(this, 0);
+        }
+        Iterator end()
+        {
+            return Iterator(this, m_Size);
+        }
+        ConstIterator begin() const
+        {
+            return ConstIterator(this, 0);
+        }
+        ConstIterator end() const
+        {
+            return ConstIterator(this, m_Size);
+        }
+        ConstIterator cbegin() const
+        {
+            return ConstIterator(this, 0);
+        }
+        ConstIterator cend() const
+        {
+            return ConstIterator(this, m_Size);
+        }
+        ReverseIterator rbegin()
+        {
+            return ReverseIterator(end());
+        }
+        ReverseIterator rend()
+        {
+            return ReverseIterator(begin());
+        }
+        ConstReverseIterator rbegin() const
+        {
+            return ConstReverseIterator(end());
+        }
+        ConstReverseIterator rend() const
+        {
+            return ConstReverseIterator(begin());
+        }
+        ConstReverseIterator crbegin() const
+        {
+            return ConstReverseIterator(cend());
+        }
+        ConstReverseIterator crend() const
+        {
+            return ConstReverseIterator(cbegin());
+        }
+
+        void push_back(const T &Value)
+        {
+            emplace_back(Value);
+        }
+
+        void push_back(T &&Value)
+        {
+            emplace_back(std::move(Value));
+        }
+
+        // Existing elements never move, so Arguments may refer into the container
+        template <typename... Args>
+        T &emplace_back(Args &&...Arguments)
+        {
+            T *Slot = NextSlot();
+            AllocTraits::construct(m_Allocator, Slot, std::forward<Args>(Arguments)...);
+            ++m_Size;
+            return *Slot;
+        }
+
+        inline void pop_back() noexcept
+        {
+            if (m_Size > 0)
+            {
+                --m_Size;
+                AllocTraits::destroy(m_Allocator, SlotFor(m_Size));
+            }
+        }
+
+        // Destroys every element, keeps the segments for reuse
+        void clear() noexcept
+        {
+            DestroyRange(0, m_Size);
+            m_Size = 0;
+        }
+
+        T &operator[](size_t Index) noexcept
+        {
+            return *SlotFor(Index);
+        }
+
+        const T &operator[](size_t Index) const noexcept
+        {
+            return *SlotFor(Index);
+        }
+
+        T &back() noexcept
+        {
+            return *SlotFor(m_Size - 1);
+        }
+
+        const T &back() const noexcept
+        {
+            return *SlotFor(m_Size - 1);
+        }
+
+        inline size_t size() const noexcept
+        {
+            return m_Size;
+        }
+
+        inline size_t capacity() const noexcept
+        {
+            return Layout::CapacityOf(m_SegmentCount);
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+        inline size_t segment_count() const noexcept
+        {
+            return m_SegmentCount;
+        }
+
+        // Allocates segments until NewCapacity elements fit
+        void reserve(size_t NewCapacity)
+        {
+            while (capacity() < NewCapacity)
+            {
+                m_Segments[m_SegmentCount] = AllocTraits::allocate(m_Allocator, Layout::SegmentCapacity(m_SegmentCount));
+                ++m_SegmentCount;
+            }
+        }
+
+        // Frees the segments that hold no elements
+        void shrink_to_fit() noexcept
+        {
+            size_t Needed = 0;
+            while (Layout::CapacityOf(Needed) < m_Size)
+            {
+                Needed++;
+            }
+            ReleaseSegments(Needed);
+        }
+
+        // Calls Function(Data, Count) for every segment's filled part, in order.
+        // The fast way to scan the container.
+        template <typename F>
+        void for_each_segment(F Function)
+        {
+            for (size_t Segment = 0; Layout::SegmentBase(Segment) < m_Size; Segment++)
+            {
+                size_t Base = Layout::SegmentBase(Segment);
+                Function(m_Segments[Segment], std::min(m_Size - Base, Layout::SegmentCapacity(Segment)));
+            }
+        }
+
+        template <typename F>
+        void for_each_segment(F Function) const
+        {
+            for (size_t Segment = 0; Layout::SegmentBase(Segment) < m_Size; Segment++)
+            {
+                size_t Base = Layout::SegmentBase(Segment);
+                Function(static_cast<const T *>(m_Segments[Segment]), std::min(m_Size - Base, Layout::SegmentCapacity(Segment)));
+            }
+        }
+
+        Alloc get_allocator() const noexcept
+        {
+            return m_Allocator;
+        }
+
+    private:
+        T *m_Segments[Layout::MaxSegments] = {};
+        size_t m_SegmentCount = 0;
+        size_t m_Size = 0;
+        [[no_unique_address]] Alloc m_Allocator;
+    };
+
+    template <typename T, typename Alloc, size_t FirstSegmentSize>
+    void swap(segmented_rotcev<T, Alloc, FirstSegmentSize> &Lhs, segmented_rotcev<T, Alloc, FirstSegmentSize> &Rhs) noexcept
+    {
+        Lhs.swap(Rhs);
+    }
+
+} // namespace blck
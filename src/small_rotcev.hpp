@@ -0,0 +1,315 @@
+#pragma once
+#include "rotcev.hpp"
+
+namespace blck
+{
+    // rotcev variant that keeps the first N elements inside the object itself.
+    // Only once the container outgrows N does it allocate, after which it
+    // behaves like a regular rotcev (same growth policies and relocation path).
+    template <typename T, size_t N, typename Alloc = malloc_allocator<T>, typename GrowthPolicy = default_growth>
+    class small_rotcev
+    {
+        static_assert(N > 0, "small_rotcev needs at least one inline element");
+
+    public:
+        using ValueType = T;
+        using AllocatorType = Alloc;
+        using GrowthPolicyType = GrowthPolicy;
+        using Iterator = RotcevIterator<small_rotcev<T, N, Alloc, GrowthPolicy>>;
+        using ConstIterator = RotcevIterator<small_rotcev<T, N, Alloc, GrowthPolicy>, true>;
+    private:
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+        T *InlineData() noexcept
+        {
+            return reinterpret_cast<T *>(m_Inline);
+        }
+
+        const T *InlineData() const noexcept
+        {
+            return reinterpret_cast<const T *>(m_Inline);
+        }
+
+        void DestroyRange(size_t From, size_t To) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (size_t i = From; i < To; i++)
+                {
+                    AllocTraits::destroy(m_Allocator, m_Start + i);
+                }
+            }
+        }
+
+        void ReleaseHeap() noexcept
+        {
+            if (!is_inline())
+            {
+                AllocTraits::deallocate(m_Allocator, m_Start, m_Capacity);
+            }
+        }
+
+        // Moves the elements into a buffer of NewCapacity, which is the inline
+        // storage when it fits
+        void Reallocate(size_t NewCapacity)
+        {
+            T *NewStart = (NewCapacity <= N) ? InlineData() : AllocTraits::allocate(m_Allocator, NewCapacity);
+            if (NewStart == m_Start)
+            {
+                return;
+            }
+            detail::RelocateElements(m_Allocator, NewStart, m_Start, m_Size);
+            ReleaseHeap();
+            m_Start = NewStart;
+            m_Capacity = (NewStart == InlineData()) ? N : NewCapacity;
+        }
+
+        template <typename U>
+        inline void AllocateNewSpace(U &&Value)
+        {
+            if (m_Capacity < m_Size + 1)
+            {
+                size_t NewCapacity = GrowthPolicy::template next_capacity<T>(m_Size, m_Size + 1);
+                T *Start = AllocTraits::allocate(m_Allocator, NewCapacity);
+
+                // Construct the new element first, Value may live inside the old buffer
+                AllocTraits::construct(m_Allocator, Start + m_Size, std::forward<U>(Value));
+                detail::RelocateElements(m_Allocator, Start, m_Start, m_Size);
+                ReleaseHeap();
+                m_Start = Start;
+                m_Capacity = NewCapacity;
+            }
+            else
+            {
+                AllocTraits::construct(m_Allocator, m_Start + m_Size, std::forward<U>(Value));
+            }
+            ++m_Size;
+        }
+
+        // Takes over Other's elements, stealing its heap buffer when it has one
+        void StealFrom(small_rotcev &Other) noexcept
+        {
+            if (Other.is_inline())
+            {
+                detail::RelocateElements(m_Allocator, m_Start, Other.m_Start, Other.m_Size);
+            }
+            else
+            {
+                m_Start = Other.m_Start;
+                m_Capacity = Other.m_Capacity;
+                Other.m_Start = Other.InlineData();
+                Other.m_Capacity = N;
+            }
+            m_Size = Other.m_Size;
+            Other.m_Size = 0;
+        }
+
+    public:
+        small_rotcev()
+        {}
+        explicit small_rotcev(const Alloc &Allocator)
+            : m_Allocator(Allocator)
+        {}
+        ~small_rotcev()
+        {
+            DestroyRange(0, m_Size);
+            ReleaseHeap();
+        }
+
+        small_rotcev(const small_rotcev &other)
+            : m_Allocator(AllocTraits::select_on_container_copy_construction(other.m_Allocator))
+        {
+            reserve(other.m_Size);
+            for (size_t i = 0; i < other.m_Size; i++)
+            {
+                AllocTraits::construct(m_Allocator, m_Start + i, other.m_Start[i]);
+            }
+            m_Size = other.m_Size;
+        }
+
+        small_rotcev(small_rotcev &&other) noexcept
+            : m_Allocator(std::move(other.m_Allocator))
+        {
+            StealFrom(other);
+        }
+
+        small_rotcev &operator=(const small_rotcev &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+                {
+                    if (m_Allocator != other.m_Allocator)
+                    {
+                        ReleaseHeap();
+                        m_Start = InlineData();
+                        m_Capacity = N;
+                    }
+                    m_Allocator = other.m_Allocator;
+                }
+                reserve(other.m_Size);
+                for (size_t i = 0; i < other.m_Size; i++)
+                {
+                    AllocTraits::construct(m_Allocator, m_Start + i, other.m_Start[i]);
+                }
+                m_Size = other.m_Size;
+            }
+            return *this;
+        }
+
+        small_rotcev &operator=(small_rotcev &&other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+        {
+            if (this != &other)
+            {
+                clear();
+                if constexpr (!AllocTraits::propagate_on_container_move_assignment::value)
+                {
+                    if (m_Allocator != other.m_Allocator)
+                    {
+                        // Different memory resources, fall back to moving element by element
+                        reserve(other.m_Size);
+                        for (size_t i = 0; i < other.m_Size; i++)
+                        {
+                            AllocTraits::construct(m_Allocator, m_Start + i, std::move(other.m_Start[i]));
+                        }
+                        m_Size = other.m_Size;
+                        other.clear();
+                        return *this;
+                    }
+                }
+                ReleaseHeap();
+                m_Start = InlineData();
+                m_Capacity = N;
+                if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+                {
+                    m_Allocator = std::move(other.m_Allocator);
+                }
+                StealFrom(other);
+            }
+            return *this;
+        }
+
+        Iterator begin()
+        {
+            return Iterator(m_Start);
+        }
+        Iterator end()
+        {
+            return Iterator(m_Start + m_Size);
+        }
+        ConstIterator begin() const
+        {
+            return ConstIterator(m_Start);
+        }
+        ConstIterator end() const
+        {
+            return ConstIterator(m_Start + m_Size);
+        }
+        ConstIterator cbegin() const
+        {
+            return ConstIterator(m_Start);
+        }
+        ConstIterator cend() const
+        {
+            return ConstIterator(m_Start + m_Size);
+        }
+
+        void push_back(const T &Value)
+        {
+            this->AllocateNewSpace(Value);
+        }
+
+        void push_back(T &&Value)
+        {
+            this->AllocateNewSpace(std::move(Value));
+        }
+
+        inline void pop_back() noexcept
+        {
+            if (m_Size > 0)
+            {
+                AllocTraits::destroy(m_Allocator, m_Start + m_Size - 1);
+                --m_Size;
+            }
+        }
+
+        void clear() noexcept
+        {
+            DestroyRange(0, m_Size);
+            m_Size = 0;
+        }
+
+        T &operator[](size_t Index)
+        {
+            return *(m_Start + Index);
+        }
+
+        const T &operator[](size_t Index) const
+        {
+            return *(m_Start + Index);
+        }
+
+        inline size_t size() const noexcept
+        {
+            return m_Size;
+        }
+
+        inline size_t capacity() const noexcept
+        {
+            return m_Capacity;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return m_Size == 0;
+        }
+
+        // True while the elements still live in the inline buffer
+        inline bool is_inline() const noexcept
+        {
+            return m_Start == InlineData();
+        }
+
+        inline T *data() noexcept
+        {
+            return m_Start;
+        }
+
+        inline const T *data() const noexcept
+        {
+            return m_Start;
+        }
+
+        void reserve(size_t NewCapacity)
+        {
+            if (NewCapacity > m_Capacity)
+            {
+                Reallocate(NewCapacity);
+            }
+        }
+
+        // Moves the elements back inline when they fit, otherwise trims the heap buffer
+        void shrink_to_fit()
+        {
+            if (!is_inline() && m_Capacity > m_Size)
+            {
+                Reallocate(m_Size);
+            }
+        }
+
+        Alloc get_allocator() const noexcept
+        {
+            return m_Allocator;
+        }
+
+    private:
+        T *m_Start = InlineData();
+        size_t m_Size = 0;
+        size_t m_Capacity = N;
+        [[no_unique_address]] Alloc m_Allocator;
+        alignas(T) unsigned char m_Inline[sizeof(T) * N];
+    };
+
+} // namespace blck
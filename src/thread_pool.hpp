@@ -0,0 +1,257 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace blck
+{
+    // Small work-stealing thread pool.
+    // Every worker owns a deque: it pushes and pops its own tasks at the back
+    // (LIFO, cache friendly for recursive splitting) and steals from the front
+    // of the other workers' deques when it runs dry. Tasks submitted from
+    // outside the pool are spread round-robin over the workers.
+    class thread_pool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        explicit thread_pool(size_t ThreadCount = std::thread::hardware_concurrency())
+        {
+            if (ThreadCount == 0)
+            {
+                ThreadCount = 1;
+            }
+            m_Queues.reserve(ThreadCount);
+            for (size_t i = 0; i < ThreadCount; i++)
+            {
+                m_Queues.push_back(std::make_unique<WorkerQueue>());
+            }
+            m_Workers.reserve(ThreadCount);
+            for (size_t i = 0; i < ThreadCount; i++)
+            {
+                m_Workers.emplace_back([this, i] { WorkerLoop(i); });
+            }
+        }
+
+        // Finishes every queued task, then joins the workers
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(m_SleepMutex);
+                m_Stop = true;
+            }
+            m_WakeUp.notify_all();
+            for (std::thread &Worker : m_Workers)
+            {
+                Worker.join();
+            }
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        size_t size() const noexcept
+        {
+            return m_Workers.size();
+        }
+
+        // Queues a task. Use task_group to wait for it or to collect its exception.
+        void submit(Task Work)
+        {
+            size_t Index = (t_Owner == this) ? t_WorkerIndex : m_NextQueue.fetch_add(1, std::memory_order_relaxed) % m_Queues.size();
+            {
+                std::lock_guard<std::mutex> Lock(m_Queues[Index]->m_Mutex);
+                m_Queues[Index]->m_Tasks.push_back(std::move(Work));
+            }
+            {
+                // Counted under the sleep mutex so a worker about to sleep cannot miss it
+                std::lock_guard<std::mutex> Lock(m_SleepMutex);
+                m_Queued.fetch_add(1, std::memory_order_relaxed);
+            }
+            m_WakeUp.notify_one();
+        }
+
+        // Runs one queued task on the calling thread if there is any.
+        // Waiting threads call this so nested parallel work cannot deadlock.
+        bool run_pending_task()
+        {
+            size_t Home = (t_Owner == this) ? t_WorkerIndex : 0;
+            Task Work;
+            if (!TakeTask(Home, Work))
+            {
+                return false;
+            }
+            Work();
+            return true;
+        }
+
+        // Index of the calling worker, size() for threads outside this pool
+        size_t worker_index() const noexcept
+        {
+            return (t_Owner == this) ? t_WorkerIndex : size();
+        }
+
+        // Process wide pool with one worker per hardware thread
+        static thread_pool &global()
+        {
+            static thread_pool Pool;
+            return Pool;
+        }
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex m_Mutex;
+            std::deque<Task> m_Tasks;
+        };
+
+        // Own queue from the back first, then steal from the front of the others
+        bool TakeTask(size_t Home, Task &Work)
+        {
+            if (m_Queued.load(std::memory_order_relaxed) == 0)
+            {
+                return false;
+            }
+            {
+                WorkerQueue &Own = *m_Queues[Home];
+                std::lock_guard<std::mutex> Lock(Own.m_Mutex);
+                if (!Own.m_Tasks.empty())
+                {
+                    Work = std::move(Own.m_Tasks.back());
+                    Own.m_Tasks.pop_back();
+                    m_Queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            for (size_t Offset = 1; Offset < m_Queues.size(); Offset++)
+            {
+                WorkerQueue &Victim = *m_Queues[(Home + Offset) % m_Queues.size()];
+                std::lock_guard<std::mutex> Lock(Victim.m_Mutex);
+                if (!Victim.m_Tasks.empty())
+                {
+                    Work = std::move(Victim.m_Tasks.front());
+                    Victim.m_Tasks.pop_front();
+                    m_Queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void WorkerLoop(size_t Index)
+        {
+            t_Owner = this;
+            t_WorkerIndex = Index;
+            Task Work;
+            while (true)
+            {
+                if (TakeTask(Index, Work))
+                {
+                    Work();
+                    Work = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> Lock(m_SleepMutex);
+                m_WakeUp.wait(Lock, [this] { return m_Stop || m_Queued.load(std::memory_order_relaxed) > 0; });
+                if (m_Stop && m_Queued.load(std::memory_order_relaxed) == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+        std::vector<std::thread> m_Workers;
+        std::mutex m_SleepMutex;
+        std::condition_variable m_WakeUp;
+        std::atomic<size_t> m_Queued{0};
+        std::atomic<size_t> m_NextQueue{0};
+        bool m_Stop = false;
+
+        static inline thread_local thread_pool *t_Owner = nullptr;
+        static inline thread_local size_t t_WorkerIndex = 0;
+    };
+
+    // Set of tasks that can be waited on together.
+    // wait() helps running queued tasks instead of blocking, and rethrows the
+    // first exception any of the group's tasks threw.
+    class task_group
+    {
+    public:
+        explicit task_group(thread_pool &Pool = thread_pool::global())
+            : m_Pool(Pool)
+        {}
+
+        ~task_group()
+        {
+            WaitForAll();
+        }
+
+        task_group(const task_group &) = delete;
+        task_group &operator=(const task_group &) = delete;
+
+        template <typename F>
+        void run(F &&Work)
+        {
+            m_Pending.fetch_add(1, std::memory_order_relaxed);
+            m_Pool.submit([this, Work = std::forward<F>(Work)]() mutable {
+                try
+                {
+                    Work();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> Lock(m_ErrorMutex);
+                    if (!m_Error)
+                    {
+                        m_Error = std::current_exception();
+                    }
+                }
+                m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        }
+
+        void wait()
+        {
+            WaitForAll();
+            if (m_Error)
+            {
+                std::exception_ptr Error = std::move(m_Error);
+                m_Error = nullptr;
+                std::rethrow_exception(Error);
+            }
+        }
+
+        thread_pool &pool() noexcept
+        {
+            return m_Pool;
+        }
+
+    private:
+        void WaitForAll() noexcept
+        {
+            while (m_Pending.load(std::memory_order_acquire) > 0)
+            {
+                if (!m_Pool.run_pending_task())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        thread_pool &m_Pool;
+        std::atomic<size_t> m_Pending{0};
+        std::mutex m_ErrorMutex;
+        std::exception_ptr m_Error;
+    };
+
+} // namespace blck
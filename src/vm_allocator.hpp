@@ -0,0 +1,166 @@
+#pragma once
+#include <malloc.h>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "allocation_size.hpp"
+
+namespace blck
+{
+    // Allocator for very large buffers of trivially relocatable data.
+    // Below ThresholdBytes it behaves like malloc_allocator (realloc for growth).
+    // At or above it the buffer is an anonymous mapping that grows with mremap,
+    // so the kernel remaps pages instead of copying them. With HugePages the
+    // mapping is marked MADV_HUGEPAGE to ask for transparent huge pages.
+    // Off Linux everything falls back to malloc/realloc.
+    template <typename T, size_t ThresholdBytes = (size_t(4) << 20), bool HugePages = false>
+    struct vm_allocator
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = vm_allocator<U, ThresholdBytes, HugePages>;
+        };
+
+        vm_allocator() noexcept = default;
+
+        template <typename U>
+        vm_allocator(const vm_allocator<U, ThresholdBytes, HugePages> &) noexcept {}
+
+        T *allocate(size_t Count)
+        {
+            detail::CheckAllocationCount<T>(Count);
+            size_t Bytes = sizeof(T) * Count;
+            void *Memory = IsMapped(Bytes) ? MapPages(Bytes) : malloc(Bytes);
+            if (!Memory)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(Memory);
+        }
+
+        void deallocate(T *Ptr, size_t Count) noexcept
+        {
+            size_t Bytes = sizeof(T) * Count;
+            if (IsMapped(Bytes))
+            {
+#if defined(__linux__)
+                munmap(Ptr, PageRound(Bytes));
+#endif
+            }
+            else
+            {
+                free(Ptr);
+            }
+        }
+
+        // Grows or shrinks a buffer of trivially relocatable elements, keeping its contents.
+        // Used by rotcev instead of allocate + memcpy + deallocate.
+        T *reallocate(T *Ptr, size_t OldCount, size_t NewCount)
+        {
+            detail::CheckAllocationCount<T>(NewCount);
+            size_t OldBytes = sizeof(T) * OldCount;
+            size_t NewBytes = sizeof(T) * NewCount;
+            void *Memory = nullptr;
+
+            if (!IsMapped(OldBytes) && !IsMapped(NewBytes))
+            {
+                Memory = realloc(static_cast<void *>(Ptr), NewBytes);
+            }
+#if defined(__linux__)
+            else if (IsMapped(OldBytes) && IsMapped(NewBytes))
+            {
+                Memory = mremap(Ptr, PageRound(OldBytes), PageRound(NewBytes), MREMAP_MAYMOVE);
+                if (Memory == MAP_FAILED)
+                {
+                    Memory = nullptr;
+                }
+                else
+                {
+                    AdviseHugePages(Memory, PageRound(NewBytes));
+                }
+            }
+#endif
+            else
+            {
+                // Crossing the threshold, one copy into the new kind of storage
+                Memory = allocate(NewCount);
+                std::memcpy(Memory, (void *)Ptr, OldBytes < NewBytes ? OldBytes : NewBytes);
+                deallocate(Ptr, OldCount);
+            }
+
+            if (!Memory)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(Memory);
+        }
+
+        template <typename U>
+        bool operator==(const vm_allocator<U, ThresholdBytes, HugePages> &) const noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const vm_allocator<U, ThresholdBytes, HugePages> &) const noexcept
+        {
+            return false;
+        }
+
+    private:
+        static bool IsMapped(size_t Bytes) noexcept
+        {
+#if defined(__linux__)
+            return Bytes >= ThresholdBytes;
+#else
+            (void)Bytes;
+            return false;
+#endif
+        }
+
+#if defined(__linux__)
+        static size_t PageRound(size_t Bytes) noexcept
+        {
+            static const size_t PageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            return (Bytes + PageSize - 1) & ~(PageSize - 1);
+        }
+
+        static void AdviseHugePages(void *Memory, size_t Bytes) noexcept
+        {
+#if defined(MADV_HUGEPAGE)
+            if constexpr (HugePages)
+            {
+                madvise(Memory, Bytes, MADV_HUGEPAGE);
+            }
+#endif
+            (void)Memory;
+            (void)Bytes;
+        }
+
+        static void *MapPages(size_t Bytes) noexcept
+        {
+            void *Memory = mmap(nullptr, PageRound(Bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (Memory == MAP_FAILED)
+            {
+                return nullptr;
+            }
+            AdviseHugePages(Memory, PageRound(Bytes));
+            return Memory;
+        }
+#else
+        static void *MapPages(size_t) noexcept
+        {
+            return nullptr;
+        }
+#endif
+    };
+
+} // namespace blck
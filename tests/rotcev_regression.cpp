@@ -0,0 +1,662 @@
+// Regression checks for container bugs that were found in review. Each check
+// reproduces the failing call; run under the Sanitize build to catch memory
+// errors, not only wrong values.
+#include "rotcev.hpp"
+#include "jagged_rotcev.hpp"
+#include "rotcev_io.hpp"
+#include "rotcev_simd.hpp"
+#include "small_rotcev.hpp"
+#include "segmented_rotcev.hpp"
+#include "incremental_rotcev.hpp"
+#include "mapped_rotcev.hpp"
+#include "monotonic_arena.hpp"
+#include "vm_allocator.hpp"
+#include "rotcev_concurrent.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+static int g_Failures = 0;
+
+#define CHECK(Condition)                                                              \
+    do                                                                                \
+    {                                                                                 \
+        if (!(Condition))                                                             \
+        {                                                                             \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #Condition ") failed\n"; \
+            g_Failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+// Appending a container to itself while it has to grow
+static void SelfAppend()
+{
+    blck::rotcev<int> Ints;
+    for (int i = 0; i < 5; i++)
+    {
+        Ints.push_back(i);
+    }
+    Ints.shrink_to_fit();
+    Ints.append_range(Ints);
+    CHECK(Ints.size() == 10);
+    for (int i = 0; i < 10; i++)
+    {
+        CHECK(Ints[i] == i % 5);
+    }
+
+    Ints.shrink_to_fit();
+    Ints.append(Ints.begin(), Ints.end());
+    CHECK(Ints.size() == 20);
+    CHECK(Ints[19] == 4);
+
+    blck::rotcev<std::string> Strings;
+    for (int i = 0; i < 5; i++)
+    {
+        Strings.push_back(std::string(32, static_cast<char>('a' + i)));
+    }
+    Strings.shrink_to_fit();
+    Strings.append(Strings.begin(), Strings.end());
+    CHECK(Strings.size() == 10);
+    CHECK(Strings[7] == std::string(32, 'c'));
+
+    Strings.shrink_to_fit();
+    Strings.append_range(Strings);
+    CHECK(Strings.size() == 20);
+    CHECK(Strings[19] == std::string(32, 'e'));
+
+    // Duplicating a row of the same jagged container
+    blck::jagged_rotcev<int> Jagged;
+    Jagged.push_row({1, 2, 3});
+    Jagged.push_row(Jagged[0].begin(), Jagged[0].end());
+    Jagged.push_row_range(Jagged[1]);
+    CHECK(Jagged.row_count() == 3 && Jagged.size() == 9);
+    CHECK(Jagged[2].size() == 3 && Jagged[2][2] == 3);
+}
+
+// Range insert of the container's own elements, both relocation paths
+static void SelfInsert()
+{
+    blck::rotcev<std::string> Strings;
+    for (int i = 0; i < 4; i++)
+    {
+        Strings.push_back(std::string(32, static_cast<char>('a' + i)));
+    }
+    Strings.shrink_to_fit();
+    Strings.insert(Strings.begin(), Strings.begin(), Strings.end());
+    CHECK(Strings.size() == 8);
+    for (int i = 0; i < 8; i++)
+    {
+        CHECK(Strings[i] == std::string(32, static_cast<char>('a' + i % 4)));
+    }
+
+    Strings.shrink_to_fit();
+    Strings.insert(Strings.begin() + 1, Strings.begin() + 2, Strings.begin() + 4);
+    CHECK(Strings.size() == 10);
+    CHECK(Strings[1] == std::string(32, 'c') && Strings[2] == std::string(32, 'd') && Strings[3] == std::string(32, 'b'));
+
+    blck::rotcev<int> Ints;
+    for (int i = 0; i < 4; i++)
+    {
+        Ints.push_back(i);
+    }
+    Ints.shrink_to_fit();
+    Ints.insert(Ints.begin() + 2, Ints.begin(), Ints.end());
+    CHECK(Ints.size() == 8);
+    CHECK(Ints[1] == 1 && Ints[2] == 0 && Ints[5] == 3 && Ints[6] == 2);
+}
+
+// Counts whose byte size overflows size_t must not become a tiny block
+static void AllocationOverflow()
+{
+    blck::malloc_allocator<int> Allocator;
+    bool Threw = false;
+    try
+    {
+        Allocator.allocate((size_t(1) << 62) + 1);
+    }
+    catch (const std::bad_array_new_length &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw);
+
+    int *Block = Allocator.allocate(4);
+    Threw = false;
+    try
+    {
+        Block = Allocator.reallocate(Block, 4, size_t(1) << 62);
+    }
+    catch (const std::bad_array_new_length &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw);
+    Allocator.deallocate(Block, 4);
+
+    blck::rotcev<int> Ints;
+    Threw = false;
+    try
+    {
+        Ints.reserve(size_t(1) << 62);
+    }
+    catch (const std::bad_alloc &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw && Ints.capacity() == 0);
+
+    // Same for the arena: the element count and the byte size plus alignment
+    blck::monotonic_arena Arena;
+    blck::arena_allocator<int> ArenaAllocator(Arena);
+    Threw = false;
+    try
+    {
+        ArenaAllocator.allocate((size_t(1) << 62) + 1);
+    }
+    catch (const std::bad_array_new_length &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw);
+
+    Arena.allocate(16);
+    Threw = false;
+    try
+    {
+        Arena.allocate(SIZE_MAX - 8, 64);
+    }
+    catch (const std::bad_alloc &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw && Arena.bytes_allocated() == 16);
+
+    // and before mmap/mremap in vm_allocator
+    blck::vm_allocator<int, 4096> Pages;
+    Threw = false;
+    try
+    {
+        Pages.allocate((size_t(1) << 62) + 1);
+    }
+    catch (const std::bad_array_new_length &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw);
+
+    int *Mapped = Pages.allocate(2048);
+    Threw = false;
+    try
+    {
+        Mapped = Pages.reallocate(Mapped, 2048, (size_t(1) << 62) + 1);
+    }
+    catch (const std::bad_array_new_length &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw);
+    Pages.deallocate(Mapped, 2048);
+}
+
+// Growth steps near the top of size_t saturate instead of wrapping or looping
+static void GrowthSaturation()
+{
+    const size_t Huge = SIZE_MAX / 8;
+    const size_t MaxInts = SIZE_MAX / sizeof(int);
+    CHECK(blck::default_growth::next_capacity<int>(Huge, Huge + 1) == MaxInts);
+    CHECK((blck::geometric_growth<3, 2>::next_capacity<int>(Huge, Huge + 1) == MaxInts));
+    size_t Rounded = blck::power_of_two_growth::next_capacity<int>(Huge, Huge + 1);
+    CHECK(Rounded > Huge && Rounded <= MaxInts);
+    CHECK(blck::power_of_two_growth::next_capacity<int>(100, 101) == 256);
+    size_t Paged = blck::page_aligned_growth<>::next_capacity<int>(Huge, Huge + 1);
+    CHECK(Paged > Huge && Paged <= MaxInts);
+    CHECK(blck::capped_linear_growth<>::next_capacity<char>(SIZE_MAX - 4, SIZE_MAX - 3) == SIZE_MAX);
+
+    bool Threw = false;
+    try
+    {
+        blck::detail::RoundUpToPowerOfTwo(SIZE_MAX);
+    }
+    catch (const std::length_error &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw);
+    CHECK(blck::detail::RoundUpToPowerOfTwo(SIZE_MAX / 2 + 1) == SIZE_MAX / 2 + 1);
+}
+
+// Writes Source and patches the element count of the header (bytes 16-23)
+template <typename Container>
+static std::string WithCount(const Container &Source, uint64_t Count, size_t At = 16)
+{
+    std::stringstream Out;
+    blck::write_binary(Out, Source);
+    std::string Bytes = Out.str();
+    std::memcpy(&Bytes[At], &Count, sizeof(Count));
+    return Bytes;
+}
+
+template <typename Container>
+static bool ReadFails(const std::string &Bytes)
+{
+    std::stringstream In(Bytes);
+    Container Dest;
+    try
+    {
+        blck::read_binary(In, Dest);
+    }
+    catch (const std::runtime_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+// Element counts read from a stream are not trusted
+static void CorruptBinaryCounts()
+{
+    blck::rotcev<int> Ints;
+    for (int i = 0; i < 4; i++)
+    {
+        Ints.push_back(i);
+    }
+    CHECK(ReadFails<blck::rotcev<int>>(WithCount(Ints, uint64_t(1) << 62)));
+    CHECK(ReadFails<blck::rotcev<int>>(WithCount(Ints, UINT64_MAX)));
+    CHECK(ReadFails<blck::rotcev<int>>(WithCount(Ints, 5)));
+    CHECK(!ReadFails<blck::rotcev<int>>(WithCount(Ints, 4)));
+
+    // Length of the first inner container, right after the header
+    blck::rotcev<blck::rotcev<int>> Nested;
+    Nested.push_back(Ints);
+    CHECK(ReadFails<blck::rotcev<blck::rotcev<int>>>(WithCount(Nested, uint64_t(1) << 62, 24)));
+    CHECK(ReadFails<blck::rotcev<blck::rotcev<int>>>(WithCount(Nested, uint64_t(1) << 40, 24)));
+    CHECK(ReadFails<blck::rotcev<blck::rotcev<int>>>(WithCount(Nested, uint64_t(1) << 40)));
+
+    std::stringstream In(WithCount(Ints, uint64_t(1) << 62));
+    bool Threw = false;
+    try
+    {
+        blck::binary_chunk_reader<int> Reader(In, 2);
+    }
+    catch (const std::runtime_error &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw);
+}
+
+// iterator and const_iterator compare and subtract in either order
+static void MixedIterators()
+{
+    blck::rotcev<int> Ints;
+    for (int i = 0; i < 4; i++)
+    {
+        Ints.push_back(i);
+    }
+    blck::rotcev<int>::iterator First = Ints.begin();
+    blck::rotcev<int>::const_iterator Last = Ints.cend();
+    blck::rotcev<int>::const_iterator ConstFirst = Ints.cbegin();
+
+    CHECK(First == ConstFirst && ConstFirst == First);
+    CHECK(!(First != ConstFirst) && !(ConstFirst != First));
+    CHECK(First < Last && Last > First);
+    CHECK(First <= ConstFirst && ConstFirst >= First);
+    CHECK(Last - First == 4 && First - Last == -4);
+    CHECK(std::distance(ConstFirst, Last) == 4);
+
+    // Same for the index based iterator of the segmented containers
+    blck::segmented_rotcev<int> Segmented;
+    blck::incremental_rotcev<int> Incremental;
+    for (int i = 0; i < 4; i++)
+    {
+        Segmented.push_back(i);
+        Incremental.push_back(i);
+    }
+    blck::segmented_rotcev<int>::iterator SegmentedFirst = Segmented.begin();
+    blck::segmented_rotcev<int>::const_iterator SegmentedLast = Segmented.cend();
+    CHECK(SegmentedFirst == Segmented.cbegin() && Segmented.cbegin() == SegmentedFirst);
+    CHECK(SegmentedFirst != SegmentedLast && SegmentedLast != SegmentedFirst);
+    CHECK(SegmentedFirst < SegmentedLast && SegmentedLast > SegmentedFirst);
+    CHECK(SegmentedFirst <= SegmentedLast && SegmentedLast >= SegmentedFirst);
+    CHECK(SegmentedLast - SegmentedFirst == 4 && SegmentedFirst - SegmentedLast == -4);
+    CHECK(Incremental.cend() - Incremental.begin() == 4 && Incremental.begin() != Incremental.cend());
+}
+
+// In-place transforms, In and Out the same container
+static void InPlaceTransform()
+{
+    blck::rotcev<float> Values;
+    for (int i = 0; i < 1000; i++)
+    {
+        Values.push_back(static_cast<float>(i));
+    }
+    blck::simd::transform(Values, Values, [](float Value) { return Value * 2.0f + 1.0f; });
+    CHECK(Values.size() == 1000 && Values[0] == 1.0f && Values[999] == 1999.0f);
+    blck::simd::transform(Values, Values, 0.5f, -0.5f);
+    CHECK(Values[0] == 0.0f && Values[999] == 999.0f);
+}
+
+// Allocator with identity that does not propagate on move assignment;
+// every block has to come back to the allocator that handed it out
+template <typename T>
+struct TaggedAllocator
+{
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::false_type;
+    using is_always_equal = std::false_type;
+
+    static std::map<void *, int> &Owners()
+    {
+        static std::map<void *, int> Blocks;
+        return Blocks;
+    }
+
+    explicit TaggedAllocator(int Tag = 0) noexcept
+        : m_Tag(Tag)
+    {}
+
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U> &Other) noexcept
+        : m_Tag(Other.m_Tag)
+    {}
+
+    T *allocate(size_t Count)
+    {
+        T *Block = std::allocator<T>().allocate(Count);
+        Owners()[Block] = m_Tag;
+        return Block;
+    }
+
+    void deallocate(T *Block, size_t Count) noexcept
+    {
+        auto Owner = Owners().find(Block);
+        CHECK(Owner != Owners().end() && Owner->second == m_Tag);
+        if (Owner != Owners().end())
+        {
+            Owners().erase(Owner);
+        }
+        std::allocator<T>().deallocate(Block, Count);
+    }
+
+    template <typename U>
+    bool operator==(const TaggedAllocator<U> &Other) const noexcept
+    {
+        return m_Tag == Other.m_Tag;
+    }
+
+    template <typename U>
+    bool operator!=(const TaggedAllocator<U> &Other) const noexcept
+    {
+        return m_Tag != Other.m_Tag;
+    }
+
+    int m_Tag;
+};
+
+// Move assignment between unequal, non-propagating allocators
+static void UnequalAllocatorMove()
+{
+    using Small = blck::small_rotcev<std::string, 2, TaggedAllocator<std::string>>;
+    static_assert(!std::is_nothrow_move_assignable_v<Small>, "element-wise fallback may allocate");
+    {
+        Small Source{TaggedAllocator<std::string>(1)};
+        Small Dest{TaggedAllocator<std::string>(2)};
+        for (int i = 0; i < 8; i++)
+        {
+            Source.push_back(std::string(32, static_cast<char>('a' + i)));
+        }
+        Dest = std::move(Source);
+        CHECK(Dest.size() == 8 && Dest[7] == std::string(32, 'h'));
+        CHECK(Source.size() == 0);
+    }
+    CHECK(TaggedAllocator<std::string>::Owners().empty());
+
+    using Segmented = blck::segmented_rotcev<std::string, TaggedAllocator<std::string>>;
+    static_assert(!std::is_nothrow_move_assignable_v<Segmented>, "element-wise fallback may allocate");
+    {
+        Segmented Source{TaggedAllocator<std::string>(1)};
+        Segmented Dest{TaggedAllocator<std::string>(2)};
+        for (int i = 0; i < 100; i++)
+        {
+            Source.push_back(std::string(32, static_cast<char>('a' + i % 26)));
+        }
+        Dest.push_back("dropped");
+        Dest = std::move(Source);
+        CHECK(Dest.size() == 100 && Dest[99] == std::string(32, 'v'));
+        CHECK(Source.size() == 0);
+    }
+    CHECK(TaggedAllocator<std::string>::Owners().empty());
+
+    using Incremental = blck::incremental_rotcev<std::string, TaggedAllocator<std::string>>;
+    static_assert(!std::is_nothrow_move_assignable_v<Incremental>, "element-wise fallback may allocate");
+    {
+        Incremental Source{TaggedAllocator<std::string>(1)};
+        Incremental Dest{TaggedAllocator<std::string>(2)};
+        // Stop with a migration in flight
+        for (int i = 0; i < 100 || !Source.migrating(); i++)
+        {
+            Source.push_back(std::string(32, static_cast<char>('a' + i % 26)));
+        }
+        size_t Count = Source.size();
+        Dest.push_back("dropped");
+        Dest = std::move(Source);
+        CHECK(Dest.size() == Count && Dest[0] == std::string(32, 'a'));
+        CHECK(Dest[Count - 1] == std::string(32, static_cast<char>('a' + (Count - 1) % 26)));
+        CHECK(Source.size() == 0);
+    }
+    CHECK(TaggedAllocator<std::string>::Owners().empty());
+}
+
+// TaggedAllocator that does propagate on copy assignment
+template <typename T>
+struct CopiedTaggedAllocator : TaggedAllocator<T>
+{
+    using propagate_on_container_copy_assignment = std::true_type;
+
+    explicit CopiedTaggedAllocator(int Tag = 0) noexcept
+        : TaggedAllocator<T>(Tag)
+    {}
+
+    template <typename U>
+    CopiedTaggedAllocator(const CopiedTaggedAllocator<U> &Other) noexcept
+        : TaggedAllocator<T>(Other.m_Tag)
+    {}
+};
+
+// Copy assignment takes the source's allocator and frees the old blocks with the old one
+static void CopyAssignPropagates()
+{
+    using Segmented = blck::segmented_rotcev<std::string, CopiedTaggedAllocator<std::string>>;
+    {
+        Segmented Source{CopiedTaggedAllocator<std::string>(1)};
+        Segmented Dest{CopiedTaggedAllocator<std::string>(2)};
+        for (int i = 0; i < 100; i++)
+        {
+            Source.push_back(std::string(32, static_cast<char>('a' + i % 26)));
+            Dest.push_back("dropped");
+        }
+        Dest = Source;
+        CHECK(Dest.get_allocator().m_Tag == 1);
+        CHECK(Dest.size() == 100 && Dest[99] == std::string(32, 'v'));
+    }
+    CHECK(TaggedAllocator<std::string>::Owners().empty());
+
+    using Small = blck::small_rotcev<std::string, 2, CopiedTaggedAllocator<std::string>>;
+    {
+        Small Source{CopiedTaggedAllocator<std::string>(1)};
+        Small Dest{CopiedTaggedAllocator<std::string>(2)};
+        for (int i = 0; i < 8; i++)
+        {
+            Source.push_back(std::string(32, static_cast<char>('a' + i)));
+            Dest.push_back("dropped");
+        }
+        Dest = Source;
+        CHECK(Dest.get_allocator().m_Tag == 1);
+        CHECK(Dest.size() == 8 && Dest[7] == std::string(32, 'h'));
+    }
+    CHECK(TaggedAllocator<std::string>::Owners().empty());
+}
+
+// swap exchanges the segments without moving elements
+static void SegmentedSwap()
+{
+    blck::segmented_rotcev<std::string> First;
+    blck::segmented_rotcev<std::string> Second;
+    for (int i = 0; i < 100; i++)
+    {
+        First.push_back(std::string(32, static_cast<char>('a' + i % 26)));
+    }
+    Second.push_back("second");
+    const std::string *Address = &First[50];
+    swap(First, Second);
+    CHECK(First.size() == 1 && First[0] == "second");
+    CHECK(Second.size() == 100 && &Second[50] == Address && Second[99] == std::string(32, 'v'));
+}
+
+struct ThrowingMove
+{
+    ThrowingMove(int Value)
+        : m_Value(Value)
+    {}
+    ThrowingMove(const ThrowingMove &Other)
+        : m_Value(Other.m_Value)
+    {}
+    ThrowingMove(ThrowingMove &&Other) noexcept(false)
+        : m_Value(Other.m_Value)
+    {}
+    int m_Value;
+};
+
+// Migration runs in noexcept code, so types that may throw on move relocate at once
+static void IncrementalThrowingMove()
+{
+    blck::incremental_rotcev<ThrowingMove> Values;
+    for (int i = 0; i < 100; i++)
+    {
+        Values.emplace_back(i);
+        CHECK(!Values.migrating());
+    }
+    CHECK(Values.size() == 100 && Values[0].m_Value == 0 && Values[99].m_Value == 99);
+
+    blck::incremental_rotcev<int> Ints;
+    bool Migrating = false;
+    for (int i = 0; i < 100; i++)
+    {
+        Ints.push_back(i);
+        Migrating = Migrating || Ints.migrating();
+    }
+    CHECK(Migrating);
+}
+
+// A capacity in the file header so large that its byte size wraps around
+static void CorruptMappedCapacity()
+{
+    const std::string Path = "rotcev_regression_mapped.bin";
+    std::remove(Path.c_str());
+    {
+        blck::mapped_rotcev<int> Ints(Path);
+        for (int i = 0; i < 4; i++)
+        {
+            Ints.push_back(i);
+        }
+    }
+    {
+        // m_Capacity sits at offset 24 of the header; 2^62 ints are 2^64 bytes
+        std::fstream File(Path, std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t Capacity = uint64_t(1) << 62;
+        File.seekp(24);
+        File.write(reinterpret_cast<const char *>(&Capacity), sizeof(Capacity));
+    }
+    bool Threw = false;
+    try
+    {
+        blck::mapped_rotcev<int> Ints(Path, blck::map_mode::read_only);
+    }
+    catch (const std::runtime_error &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw);
+    std::remove(Path.c_str());
+}
+
+// malloc_allocator whose next allocation can be made to fail
+template <typename T>
+struct FailingAllocator : blck::malloc_allocator<T>
+{
+    static inline bool FailNext = false;
+
+    FailingAllocator() noexcept = default;
+
+    template <typename U>
+    FailingAllocator(const FailingAllocator<U> &) noexcept
+    {}
+
+    T *allocate(size_t Count)
+    {
+        if (FailNext)
+        {
+            FailNext = false;
+            throw std::bad_alloc();
+        }
+        return blck::malloc_allocator<T>::allocate(Count);
+    }
+};
+
+// A segment allocation that throws must not leave a claimed slot behind
+static void ConcurrentAllocationFailure()
+{
+    blck::rotcev_concurrent<int, FailingAllocator<int>, 4> Ints;
+    for (int i = 0; i < 4; i++)
+    {
+        Ints.push_back(i);
+    }
+    // Index 4 needs the second segment
+    FailingAllocator<int>::FailNext = true;
+    bool Threw = false;
+    try
+    {
+        Ints.push_back(4);
+    }
+    catch (const std::bad_alloc &)
+    {
+        Threw = true;
+    }
+    CHECK(Threw && Ints.size() == 4);
+
+    CHECK(Ints.push_back(4) == 4);
+    int More[3] = {5, 6, 7};
+    CHECK(Ints.append(More, 3) == 5);
+    CHECK(Ints.size() == 8 && Ints[4] == 4 && Ints[7] == 7);
+}
+
+int main()
+{
+    SelfAppend();
+    SelfInsert();
+    AllocationOverflow();
+    GrowthSaturation();
+    CorruptBinaryCounts();
+    MixedIterators();
+    InPlaceTransform();
+    UnequalAllocatorMove();
+    IncrementalThrowingMove();
+    CorruptMappedCapacity();
+    CopyAssignPropagates();
+    SegmentedSwap();
+    ConcurrentAllocationFailure();
+
+    if (g_Failures)
+    {
+        std::cerr << g_Failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "all checks passed\n";
+    return 0;
+}